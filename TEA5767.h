@@ -126,11 +126,14 @@
 #define TEA5767_DTC_50US        0
 
 #define TEA5767_DEFAULT_FREQ    87.5
+#define TEA5767_DEFAULT_CHANNEL 8750    // TEA5767_DEFAULT_FREQ in 10KHz
 #define TEA5767_XTAL            32768   // Default on board XTAL is 32768Hz
 
 #define TEA5767_ERROR           0xFF
 #define TEA5767_NOT_READY       0xFE
 #define TEA5767_READ_AGAIN      0xFD
+#define TEA5767_BAD_DATA        0xFC    // PLL = 0 after all retries
+#define TEA5767_DEADLINE        0xFB    // read_status() deadline reached
 
 #define TEA5767_MUTE_ON         1
 #define TEA5767_MUTE_OFF        0
@@ -143,55 +146,301 @@
 #define TEA5767_SEARCH_PRESET_NO    0
 #define TEA5767_SEARCH_PRESET_YES   1
 
+// Rescan routine
+#define TEA5767_RESCAN_FAILS        3       // failed re-checks in a row before a preset is removed
+#define TEA5767_RESCAN_STRIDE       2       // discovery samples every 2nd channel, next rescan the others
+#define TEA5767_RESCAN_BATCH        4       // channels per rescanProcess() of TEA5767_Task
+#define TEA5767_RESCAN_INTERVAL     3000    // ms between two discovery batches while the sound is on
+
+// Scan routine
+#define TEA5767_SCAN_STEP           0.1     // 100KHz channel step
+#define TEA5767_IF_CENTER           0x37    // IF counter of a centred station (225KHz)
+#define TEA5767_SCAN_VERIFY_NO      0
+#define TEA5767_SCAN_VERIFY_YES     1
+
+// Station detection thresholds
+#define TEA5767_IF_LOW              0x33    // fixed IF counter window, 52 -> 58
+#define TEA5767_IF_HIGH             0x3A
+#define TEA5767_IF_SPREAD_MIN       2       // +/- IF counter, narrowest adaptive window
+#define TEA5767_IF_SPREAD_MAX       6       // +/- IF counter, widest adaptive window
+#define TEA5767_NOISE_MARGIN        2       // ADC level above the noise floor
+#define TEA5767_PRESET_HEADER       10      // bytes before the channels in savePreset()
+
+// Crystal calibration
+#define TEA5767_IF_STEP             4096    // Hz per IF counter, 64 * (32768 / 512)
+#define TEA5767_CAL_READS           3       // IF counter reads per station
+#define TEA5767_CAL_IF_RANGE        8       // +/- IF counter accepted while calibrating
+#define TEA5767_CAL_IF_COARSE       54      // +/- IF counter of the first pass, TEA5767_CAL_PPM_MAX at 108MHz
+#define TEA5767_CAL_PPM_MAX         2000    // +/- ppm of the correction
+
+
+// Status budget in RAM : rawData + 2 bytes of flags
+#define TEA5767_STATUS_SIZE     7
 
+/*
+    Status of the module
+    flags written by the driver are packed in bitfields,
+    the fields of the read mode are decoded from rawData on demand
+    frequency in integer channels is in 10KHz (i.e. 87.5MHz = 8750)
+*/
 typedef struct TEA5767_Status {
-    byte rawData[5];
-
-    byte radioReady = 0;      // 1 ready, 0 no station found
-    byte reachBandLimit = 0;  // 1 reached, 0 not reached
+    byte rawData[5];  // last I2C_Read
+
+    byte readTimeout : 1;   // 1 timeout, 0 OK
+    byte Sound_Left : 1;
+    byte Sound_Right : 1;
+    byte Sound_All : 1;
+    byte searchMode : 1;
+    byte injection : 1;
+    byte SoftMute : 1;
+    byte HCC : 1;
+
+    byte SNC : 1;
+    byte DTC : 1;
+    byte dir : 1;
+    byte band : 1;
+    byte ssl : 4;           // NA/LOW/MID/HIGH, ADC level 0 ~ 15
+
+    TEA5767_Status()
+        : readTimeout(TEA5767_READ_OK),
+          Sound_Left(TEA5767_MUTE_OFF),
+          Sound_Right(TEA5767_MUTE_OFF),
+          Sound_All(TEA5767_MUTE_OFF),
+          searchMode(TEA5767_OFF),
+          injection(TEA5767_INJECTION_HIGH),
+          SoftMute(TEA5767_MUTE_OFF),
+          HCC(TEA5767_OFF),
+          SNC(TEA5767_OFF),
+          DTC(TEA5767_DTC_50US),
+          dir(TEA5767_UP),
+          band(TEA5767_US_EU),
+          ssl(TEA5767_SSL_HIGH) {
+        for (byte i = 0; i < 5; i++) {
+            rawData[i] = 0;
+        }
+    }
+
+    // data byte 1 & 2 : PLL word of the current freq
+    unsigned int PLL() const { return ((rawData[0] & 0x3F) << 8) + rawData[1]; }
+    byte radioReady() const { return (rawData[0] >> TEA5767_MASK_READY_FLAG) & 1; }          // 1 ready, 0 no station found
+    byte reachBandLimit() const { return (rawData[0] >> TEA5767_MASK_BAND_LIMIT_FLAG) & 1; }  // 1 reached, 0 not reached
+    // data byte 3
+    byte radioMode() const { return (rawData[2] >> TEA5767_MASK_READ_MODE) & 1; }
+    byte IFCounter() const { return rawData[2] & 0x7F; }  // 0x37 = 225KHz
+    // data byte 4
+    byte ADCLevel() const { return rawData[3] >> 4; }  // ADC level of the current Frequency
+
+    // Freq = PLL * XTAL / 4 -/+ IF, in 10KHz
+    // ppm : crystal error, TEA5767_Driver::xtalPPM
+    unsigned int currentChannel(int ppm = 0) const {
+        unsigned long f = (unsigned long)PLL() * TEA5767_XTAL;  // 4 * LO in Hz
+        f += (long)(f / 1000) * ppm / 1000;
+        f = (injection == TEA5767_INJECTION_HIGH) ? f - 900000UL : f + 900000UL;
+        return (f + 20000UL) / 40000UL;
+    }
+    unsigned int minChannel() const { return (band == TEA5767_JP) ? 7600 : 8750; }
+    unsigned int maxChannel() const { return (band == TEA5767_JP) ? 9100 : 10800; }
+
+    // in MHz
+    float currentFreq(int ppm = 0) const { return currentChannel(ppm) / 100.0; }
+    float minFreq() const { return minChannel() / 100.0; }
+    float maxFreq() const { return maxChannel() / 100.0; }
+} TEA5767_Status;
 
-    float currentFreq = TEA5767_DEFAULT_FREQ;
-    byte IFCounter = 0x37;  // 225KHz
-    byte readTimeout = 0;   // 1 timeout, 0 OK
+static_assert(sizeof(TEA5767_Status) <= TEA5767_STATUS_SIZE, "TEA5767_Status exceeds its RAM budget");
 
-    byte radioMode = TEA5767_STEREO;  // 1 Stereo, 0 Mono
-    byte Sound_Left = TEA5767_MUTE_OFF;
-    byte Sound_Right = TEA5767_MUTE_OFF;
-    byte Sound_All = TEA5767_MUTE_OFF;
+/*
+    Compile time config of the 5 data bytes in write mode
+    e.g. radio.init<TEA5767_Config<TEA5767_JP, 8000, TEA5767_DTC_50US>>();
+    channel is the default freq in 10KHz, it must be inside the band
+    the others follow the power on setting of init() :
+    search off, search up, stereo, L/R not muted, SWP1/2 off, not standby, 32.768KHz XTAL, soft mute off
+*/
+template <byte Band = TEA5767_US_EU,
+          unsigned int Channel = TEA5767_DEFAULT_CHANNEL,
+          byte DTC = TEA5767_DTC_50US,
+          byte SSL = TEA5767_SSL_HIGH,
+          byte Injection = TEA5767_INJECTION_HIGH,
+          byte Mute = TEA5767_MUTE_ON,
+          byte HCC = TEA5767_OFF,
+          byte SNC = TEA5767_OFF>
+struct TEA5767_Config {
+    static_assert(Band == TEA5767_JP || Band == TEA5767_US_EU, "TEA5767_Config : unknown band");
+    static_assert(Band == TEA5767_JP ? between(Channel, 7600, 9100) : between(Channel, 8750, 10800),
+                  "TEA5767_Config : default freq out of band");
+    static_assert(SSL == TEA5767_SSL_NA || SSL == TEA5767_SSL_LOW || SSL == TEA5767_SSL_MID || SSL == TEA5767_SSL_HIGH,
+                  "TEA5767_Config : unknown search stop level");
+    static_assert(DTC <= 1 && Injection <= 1 && Mute <= 1 && HCC <= 1 && SNC <= 1, "TEA5767_Config : flag must be 0 or 1");
+
+    static constexpr byte band = Band;
+    static constexpr byte dtc = DTC;
+    static constexpr byte ssl = SSL;
+    static constexpr byte injection = Injection;
+    static constexpr byte mute = Mute;
+    static constexpr byte hcc = HCC;
+    static constexpr byte snc = SNC;
+
+    // same as setFreq(), PLL = 4 * (Freq +/- IF) / XTAL, Freq in Hz
+    static constexpr unsigned long LO = (Injection == TEA5767_INJECTION_HIGH) ? Channel * 10000UL + 225000UL : Channel * 10000UL - 225000UL;
+    static constexpr unsigned int PLL = (LO * 4 + TEA5767_XTAL / 2) / TEA5767_XTAL;
+
+    static constexpr byte sslBits = (SSL == TEA5767_SSL_HIGH) ? 3 : (SSL == TEA5767_SSL_MID) ? 2 : (SSL == TEA5767_SSL_LOW) ? 1 : 0;
+
+    // data byte 1 ~ 5
+    static constexpr byte data0 = (Mute << TEA5767_MASK_MUTE) | (PLL >> 8);
+    static constexpr byte data1 = PLL & 0xFF;
+    static constexpr byte data2 = (TEA5767_UP << TEA5767_MASK_SEARCH_DIRECTION) | (sslBits << TEA5767_MASK_SSL_L) |
+                                  (Injection << TEA5767_MASK_SIDE_INJECTION);
+    static constexpr byte data3 = (Band << TEA5767_MASK_BAND) | (1 << TEA5767_MASK_XTAL) | (HCC << TEA5767_MASK_HCC) |
+                                  (SNC << TEA5767_MASK_SNC);
+    static constexpr byte data4 = DTC << TEA5767_MASK_DTC;
+};
 
-    byte searchMode = TEA5767_OFF;
+typedef TEA5767_Config<> TEA5767_DefaultConfig;
+
+// Retry policy of read_status()
+// each retry counter is the number of extra reads allowed for that failure,
+// and the whole call returns within deadline (+ one I2C transfer)
+typedef struct TEA5767_RetryPolicy {
+    byte timeoutRetry = 5;           // I2C read timeout
+    byte badDataRetry = 5;           // PLL = 0 in rawData
+    byte notReadyRetry = 5;          // ready flag not set, always because the weak signal
+    unsigned int retryInterval = 10; // ms before reading again on bad data / not ready, time for the PLL to lock
+    unsigned int readTimeout = 20;   // ms, timeout of each I2C_Read()
+    unsigned int deadline = 150;     // ms, total time of read_status()
+} TEA5767_RetryPolicy;
+
+// Standby / wake of pause() & resume(), and the auto standby of powerProcess()
+typedef struct TEA5767_Power {
+    unsigned long idleTimeout = 0;    // ms without I2C_Write() before auto standby, 0 = off
+    unsigned int wakeTimeout = 100;   // ms to wait the ready flag after wake
+
+    byte standby = 0;                 // 1 in standby
+    byte Sound_All = TEA5767_MUTE_OFF;  // mute before standby
+
+    unsigned long lastActivity = 0;   // now() of the last I2C_Write()
+    unsigned long standbySince = 0;
+    unsigned long standbyTime = 0;    // ms spent in standby, current standby excluded
+    unsigned long wakeLatency = 0;    // ms from wake write to lock of the last resume()
+    unsigned long wakeCount = 0;
+    byte wakeResult = TEA5767_READ_OK;  // TEA5767_READ_OK if relocked on the previous channel
+} TEA5767_Power;
+
+// Station detection thresholds of a band, measured from the scan sweep
+// ADCLevel = 0 : not measured, the fixed test (IF 0x33 ~ 0x3A, ADC >= ssl) is used
+typedef struct TEA5767_Threshold {
+    byte ADCLevel = 0;               // noise floor + TEA5767_NOISE_MARGIN
+    byte IFLow = TEA5767_IF_LOW;     // IF counter window
+    byte IFHigh = TEA5767_IF_HIGH;
+} TEA5767_Threshold;
+
+// Preset of Auto Scan
+typedef struct TEA5767_Preset {
+    float freq;
+    byte injection : 1;  // side injection found when added, a preset is tuned with a single write
+    byte fails : 7;      // failed re-checks in a row of rescanStation()
+} TEA5767_Preset;
+
+// Best hit of a run of adjacent scan hits
+// a strong station passes the IF/ADC test at 2-3 neighbouring steps, only the peak is kept
+typedef struct TEA5767_ScanPeak {
+    float freq = TEA5767_DEFAULT_FREQ;
+    byte ADCLevel = 0;
+    byte IFOffset = 0xFF;  // distance of IFCounter from TEA5767_IF_CENTER
     byte injection = TEA5767_INJECTION_HIGH;
-    byte ADCLevel = 0;  // ADC level of the current Frequency
+} TEA5767_ScanPeak;
 
-    byte SoftMute = TEA5767_MUTE_OFF;
-    byte HCC = TEA5767_OFF;
-    byte SNC = TEA5767_OFF;
-    byte DTC = TEA5767_DTC_50US;
+/*
+    Bus and Clock policies of TEA5767_Driver, resolved at compile time
+    Bus   : byte write(const byte *data, byte len);  // endTransmission() result, 0 = OK
+            byte read(byte *data, byte len);         // number of bytes received
+    Clock : unsigned long millis();
+            void delay(unsigned long ms);
+*/
+// Arduino Wire, or any TwoWire port (e.g. Wire1)
+class TEA5767_WireBus {
+   private:
+    TwoWire *wire;
+    byte address;
 
-    byte dir = TEA5767_UP;
-    byte band = TEA5767_US_EU;
-    byte ssl = TEA5767_SSL_HIGH;
-    float minFreq = 87.5;   // Default US band
-    float maxFreq = 108.0;  // Default US band
+   public:
+    TEA5767_WireBus(TwoWire &wire = Wire, byte address = TEA5767_I2C_ADDRESS) : wire(&wire), address(address) {}
+
+    byte write(const byte *data, byte len) {
+        wire->beginTransmission(address);
+        for (byte i = 0; i < len; i++) {
+            wire->write(data[i]);
+        }
+        return wire->endTransmission();
+    }
+
+    byte read(byte *data, byte len) {
+        byte rec = wire->requestFrom(address, len);
+        if (rec >= len) {
+            for (byte i = 0; i < len; i++) {
+                data[i] = wire->read();
+            }
+        }
+        return rec;
+    }
+};
 
-} TEA5767_Status;
+// Arduino millis() / delay()
+class TEA5767_ArduinoClock {
+   public:
+    unsigned long millis() { return ::millis(); }
+    void delay(unsigned long ms) { ::delay(ms); }
+};
 
-class TEA5767 {
+/*
+    Driver
+    e.g. TEA5767 radio;                                   // Wire, 0x60
+         TEA5767 radio2(TEA5767_WireBus(Wire1));          // second I2C port
+         TEA5767_Driver<MyMockBus, MyMockClock> radio3;   // test without hardware
+*/
+template <class Bus = TEA5767_WireBus, class Clock = TEA5767_ArduinoClock>
+class TEA5767_Driver {
    private:
+    Bus bus;
+    Clock clock;
     byte writeData[5];  // Write Buffer
 
-    void I2C_Write();
-    byte I2C_Read();
+    void I2C_Write(unsigned long settle = 35);  // settle in ms, wait for the IF counter
+    byte I2C_Read(unsigned long timeout);
+    void retryWait(unsigned long startTime);  // retryPolicy.retryInterval inside the deadline
+
+    // Time base
+    unsigned long now() { return clock.millis(); }
+    void wait(unsigned long ms) { clock.delay(ms); }
 
     void setOnOff(byte *data, byte bitPos, byte onOff);  // modify bit in writeData of specific parameter
 
     void optimalSideInjection(float freq);
+    byte calibratePass(const float *freqs, byte count, byte range);  // one least squares fit into xtalPPM
 
-    // Preset for Auto Scan
-    float *presetFreq;
+    // Preset for Auto Scan, in freq order
+    TEA5767_Preset *preset = NULL;
     int presetFreqSize = 0;
     int curPreset = 0;
-    void addFreqPreset(float freq);
+    void addFreqPreset(float freq, byte injection);
+    void removePreset(int i);
+    int findPreset(float freq);       // preset within one step of freq, -1 if none
+    void tunePreset(int i);           // single write with the cached injection
+    void restoreImage(const byte *image);  // write back a saved writeData
+
+    // Incremental rescan
+    unsigned int rescanCursor = 0;    // next discovery sample
+    byte rescanOffset = 0;            // first channel sampled, rotates on each rescanStation()
+    unsigned long rescanLast = 0;     // now() of the last discovery batch
+    void rescanSample(float freq, byte ssl);
+
+    // Scan post-processing
+    byte readStation(byte ssl);                                     // read_status() then isStation(), 0 if the read failed
+    byte isStation(byte ssl);                                       // IF/ADC test on the last read_status()
+    byte isStation(byte ssl, byte ADCLevel, byte IFCounter);        // IF/ADC test with threshold of the band
+    void measureThreshold(const byte *sweep, unsigned int steps);  // noise floor and IF spread of the sweep
+    void updateScanPeak(TEA5767_ScanPeak *peak, float freq, byte ADCLevel, byte IFCounter, byte injection);  // keep the best hit of the run
+    void addScanPeak(TEA5767_ScanPeak *peak, byte ssl);       // verify (optional) and add the peak to preset
     
     // Config, the following functino didn't send to the device before using I2C_Write()
     // data byte 1
@@ -221,31 +470,93 @@ class TEA5767 {
     float searchingFreq = 87.5;
     byte searchProcessStatus = 0;
     byte searchPreset = TEA5767_SEARCH_PRESET_NO;
+    byte scanVerifyPeak = TEA5767_SCAN_VERIFY_NO;  // re-check each scan peak with one extra read
+    byte adaptiveThreshold = TEA5767_OFF;          // measure threshold in scanStation() and use it instead of ssl
+    TEA5767_Threshold threshold[2];                // per band, [TEA5767_US_EU] / [TEA5767_JP]
+    int xtalPPM = 0;                               // crystal error of calibrate(), applied in setFreq() and currentFreq()
 
     TEA5767_Status status;
-    TEA5767() {
+    TEA5767_RetryPolicy retryPolicy;
+    TEA5767_Power power;
+
+    TEA5767_Driver(const Bus &bus = Bus(), const Clock &clock = Clock()) : bus(bus), clock(clock) {
         init();
     };
-    void init();  // Module config init
-
+    ~TEA5767_Driver() { free(preset); }
+
+    // owns the preset array
+    TEA5767_Driver(const TEA5767_Driver &) = delete;
+    TEA5767_Driver &operator=(const TEA5767_Driver &) = delete;
+
+    // Module config init, send the compile time image of Config by a single write
+    template <class Config = TEA5767_DefaultConfig>
+    void init() {
+        writeData[0] = Config::data0;
+        writeData[1] = Config::data1;
+        writeData[2] = Config::data2;
+        writeData[3] = Config::data3;
+        writeData[4] = Config::data4;
+
+        status.Sound_All = Config::mute;
+        status.Sound_Left = TEA5767_MUTE_OFF;
+        status.Sound_Right = TEA5767_MUTE_OFF;
+        status.dir = TEA5767_UP;
+        status.ssl = Config::ssl;
+        status.injection = Config::injection;
+        status.band = Config::band;
+        status.SoftMute = TEA5767_MUTE_OFF;
+        status.HCC = Config::hcc;
+        status.SNC = Config::snc;
+        status.DTC = Config::dtc;
+
+        I2C_Write();
+
+        // Other settings
+        searchPreset = TEA5767_SEARCH_PRESET_NO;
+    }
+
+    // Tuning, scan, preset and toggle calls wake up from standby first
     void pause();        // Put system to standby mode
-    void resume();       // Wake up from standby mode
+    byte resume();       // Wake up from standby mode, TEA5767_READ_OK if relocked
+    void touch();        // User activity, wake up if in standby
+    void powerProcess(); // Call in loop, standby after power.idleTimeout
+    unsigned long standbyTime();  // ms spent in standby, including the current one
     void printStatus();  // Print TEA5767_status data to serial port
-    byte read_status();  // read and extract I2C_Read rawData
+    unsigned int currentChannel() { return status.currentChannel(xtalPPM); }  // in 10KHz, with xtalPPM
+    float currentFreq() { return status.currentFreq(xtalPPM); }              // in MHz, with xtalPPM
+    byte read_status();  // read rawData with retryPolicy, TEA5767_READ_OK or the failure
 
     // Set station with specific frequency
     void setStation(float freq);
 
+    // Fit xtalPPM from the IF counter of known strong stations (in MHz), return the number of stations used
+    byte calibrate(const float *freqs, byte count);
+
     // Auto search/scan station
     void scanStation(byte ssl);
     void searchStation(byte dir, byte ssl);
     void searchProcess();
 
+    // Incremental rescan, keep the presets still on air and discover new ones over time
+    byte rescanStatus = TEA5767_SEARCH_STOP;
+    unsigned long rescanInterval = TEA5767_RESCAN_INTERVAL;  // ms between two batches, no limit when muted
+    void rescanStation(byte ssl);       // re-check every preset, then start the discovery
+    byte rescanProcess(byte steps);     // discovery of steps channels per batch, TEA5767_SEARCH_PENDING until the band is covered
+
     // Preset functions for Auto Scan
     void nextPreset();
     void prevPreset();
     void printPreset();
     void deleteCurFreqPreset();
+    int presetCount() { return presetFreqSize; }
+    int currentPreset() { return curPreset; }
+    float presetAt(int i) { return (between(i, 0, presetFreqSize - 1)) ? preset[i].freq : 0; }
+
+    // Persist presets with the thresholds, e.g. in EEPROM
+    // header : count[2] (ADCLevel, IFLow, IFHigh)[2 bands] xtalPPM[2], then injection[15] channel in 10KHz [14:0] per preset
+    unsigned int presetDataSize() { return TEA5767_PRESET_HEADER + presetFreqSize * 2; }
+    unsigned int savePreset(byte *buf, unsigned int len);  // return bytes written, 0 if buf too small
+    byte loadPreset(const byte *buf, unsigned int len);    // return 1 if loaded
 
     // Toggle, update device with specific flag
     void toggleMute(byte channel);
@@ -256,4 +567,8 @@ class TEA5767 {
     void toggleMode();
 };
 
+typedef TEA5767_Driver<> TEA5767;
+
+#include "TEA5767.tpp"
+
 #endif  // TEA5767_H_
@@ -0,0 +1,1269 @@
+/*
+	Project  : LaLiMat project (https://www.youtube.com/playlist?list=PLJBKmE2nNweRXOebZjydkMEiq2pHtBMOS in Chinese)
+ 	file     : TEA5767.tpp
+	Author   : ykchau
+ 	youtube  : youtube.com/ykchau888
+  	Licenese : GPL-3.0
+   	Please let me know if you use it commercial project.
+*/
+
+// Implementation of TEA5767_Driver, included at the end of TEA5767.h as the class is a template
+
+/**************************
+    private:
+**************************/
+// Write instruction to TEA5767 via I2C
+// settle in ms
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::I2C_Write(unsigned long settle) {
+    // SPH("WD1 :", writeData[0]);
+    // SPH("WD2 :", writeData[1]);
+    // SPH("WD3 :", writeData[2]);
+    // SPH("WD4 :", writeData[3]);
+    // SPH("WD5 :", writeData[4]);
+
+    bus.write(writeData, 5);
+
+    power.lastActivity = now();
+
+    // because TEA5767 need ~28ms to get the IF counter
+    // therefore we wait 35ms let it complete
+    wait(settle);
+}
+
+// Read status from TEA5767 via I2C
+// timeout in ms, a short transfer (< 5 bytes) is read again until timeout
+template <class Bus, class Clock>
+byte TEA5767_Driver<Bus, Clock>::I2C_Read(unsigned long timeout) {
+    byte data[5];
+    byte rec = 0;
+    unsigned long startTime = now();
+
+    while (rec < 5) {
+        rec = bus.read(data, 5);
+
+        if (rec < 5 && now() - startTime >= timeout) {  // wrap-safe
+            status.readTimeout = TEA5767_READ_TIMEOUT;
+            SPL("Timeout", " ");
+            break;
+        }
+        if (rec < 5) {
+            wait(1);  // let the bus go between polls
+        }
+    }
+
+    if (rec >= 5) {
+        for (byte i = 0; i < 5; i++) {
+            status.rawData[i] = data[i];
+        }
+        status.readTimeout = TEA5767_READ_OK;
+    }
+
+    return status.readTimeout;
+}
+
+// Modify bit in writeData
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::setOnOff(byte *data, byte bitPos, byte onOff) {
+    if (onOff == TEA5767_ON) {
+        bit_set(*data, bitPos);
+    } else {
+        bit_clear(*data, bitPos);
+    }
+}
+
+// Find the correct frequency by using Side injection technique
+// This process is follow the application notes
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::optimalSideInjection(float freq) {
+    // method from application note page 27
+    // https://www.voti.nl/docs/AN10133.pdf
+    // https://en.wikipedia.org/wiki/Superheterodyne_receiver#Image_frequency
+    // https://en.wikipedia.org/wiki/Image_response
+
+    byte levelLow, levelHigh;
+
+    // application note page 24,
+    // IF(MHz) = IFCounter * (64 * ( Sys clock / 512 ))/1,000,000
+    //         = IFCounter * (64 * ( 32,768 / 512 ))/1,000,000
+    //         = IFCounter * (64 * 64) / 1,000,000
+    //         = IFCounter * 0.004096
+    // 2 * IF = IFCounter * 0.004096 * 2
+    float doubleIF = 0.45;  //status.IFCounter * 0.008192;
+
+    // Test High and Low level signal of Frequency input
+    // by High/Low LO Injection by +/- 445KHz
+    setSideInjectionMode(TEA5767_INJECTION_HIGH);
+
+    setFreq(freq + doubleIF);
+    I2C_Write();
+    read_status();
+    levelHigh = status.ADCLevel();
+
+    setSideInjectionMode(TEA5767_INJECTION_LOW);
+    setFreq(freq - doubleIF);
+    I2C_Write();
+    read_status();
+    levelLow = status.ADCLevel();
+
+    status.injection = (levelHigh < levelLow) ? TEA5767_INJECTION_HIGH : TEA5767_INJECTION_LOW;
+}
+
+// Add Freq to Preset, in freq order
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::addFreqPreset(float freq, byte injection) {
+    TEA5767_Preset *p = (TEA5767_Preset *)realloc(preset, sizeof(TEA5767_Preset) * (presetFreqSize + 1));
+    if (p == NULL) {
+        SPL("Preset : not enough memory.", " ");
+        return;
+    }
+    preset = p;
+
+    int i = presetFreqSize;
+    while (i > 0 && preset[i - 1].freq > freq) {
+        preset[i] = preset[i - 1];
+        i--;
+    }
+    preset[i].freq = freq;
+    preset[i].injection = injection;
+    preset[i].fails = 0;
+
+    presetFreqSize++;
+    curPreset = i;
+}
+
+// Remove preset i, curPreset stays on the same preset if possible
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::removePreset(int i) {
+    if (!between(i, 0, presetFreqSize - 1)) {
+        return;
+    }
+
+    for (int j = i; j < presetFreqSize - 1; j++) {
+        preset[j] = preset[j + 1];
+    }
+    presetFreqSize--;
+
+    if (presetFreqSize == 0) {
+        free(preset);
+        preset = NULL;
+        curPreset = 0;
+        return;
+    }
+
+    // shrink as addFreqPreset() grows, no stale slot after the last preset
+    TEA5767_Preset *p = (TEA5767_Preset *)realloc(preset, sizeof(TEA5767_Preset) * presetFreqSize);
+    if (p != NULL) {
+        preset = p;
+    }
+
+    if (curPreset > i || curPreset >= presetFreqSize) {
+        curPreset--;
+    }
+}
+
+template <class Bus, class Clock>
+int TEA5767_Driver<Bus, Clock>::findPreset(float freq) {
+    for (int i = 0; i < presetFreqSize; i++) {
+        if (fabs(preset[i].freq - freq) < TEA5767_SCAN_STEP * 1.5) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::tunePreset(int i) {
+    status.injection = preset[i].injection;
+    setSideInjectionMode(status.injection);
+    setFreq(preset[i].freq);
+    I2C_Write();
+}
+
+// Write back a writeData saved before a rescan, the station listened resumes
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::restoreImage(const byte *image) {
+    for (byte i = 0; i < 5; i++) {
+        writeData[i] = image[i];
+    }
+    status.Sound_All = (image[0] >> TEA5767_MASK_MUTE) & 1;
+    status.injection = (image[2] >> TEA5767_MASK_SIDE_INJECTION) & 1;
+
+    I2C_Write();
+    read_status();  // status of the restored channel, not the last one sampled
+}
+
+// Good Signal test on a new read_status(), a failed read is not a station
+// on a timeout rawData still holds the previous channel
+template <class Bus, class Clock>
+byte TEA5767_Driver<Bus, Clock>::readStation(byte ssl) {
+    byte result = read_status();
+    return (result == TEA5767_READ_OK || result == TEA5767_NOT_READY) && isStation(ssl);
+}
+
+// Good Signal test on the last read_status()
+template <class Bus, class Clock>
+byte TEA5767_Driver<Bus, Clock>::isStation(byte ssl) {
+    return isStation(ssl, status.ADCLevel(), status.IFCounter());
+}
+
+// Good Signal test, fixed test unless the threshold of the band is measured
+template <class Bus, class Clock>
+byte TEA5767_Driver<Bus, Clock>::isStation(byte ssl, byte ADCLevel, byte IFCounter) {
+    const TEA5767_Threshold *th = &threshold[status.band];
+
+    if (adaptiveThreshold == TEA5767_ON && th->ADCLevel != 0) {
+        return between(IFCounter, th->IFLow, th->IFHigh) && ADCLevel >= th->ADCLevel;
+    }
+    return between(IFCounter, TEA5767_IF_LOW, TEA5767_IF_HIGH) && ADCLevel >= ssl;  // 52 -> 58
+}
+
+// Threshold of the current band from the scan sweep
+// sweep : ADC level [7:4], signed IF counter offset from TEA5767_IF_CENTER [3:0] per step
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::measureThreshold(const byte *sweep, unsigned int steps) {
+    TEA5767_Threshold *th = &threshold[status.band];
+    unsigned int hist[16] = {0};
+
+    // noise floor, median ADC level of the band as most of the steps are empty
+    for (unsigned int i = 0; i < steps; i++) {
+        hist[sweep[i] >> 4]++;
+    }
+    byte noiseFloor = 0;
+    unsigned int n = hist[0];
+    while (noiseFloor < 15 && n * 2 < steps) {
+        n += hist[++noiseFloor];
+    }
+    th->ADCLevel = min(noiseFloor + TEA5767_NOISE_MARGIN, 15);
+
+    // IF counter spread of the steps above the noise, mean and mean absolute deviation
+    int sum = 0;
+    n = 0;
+    for (unsigned int i = 0; i < steps; i++) {
+        if ((sweep[i] >> 4) >= th->ADCLevel) {
+            sum += ((sweep[i] & 0x0F) ^ 8) - 8;
+            n++;
+        }
+    }
+
+    if (n >= 3) {
+        int mean = (sum >= 0) ? (sum + (int)n / 2) / (int)n : (sum - (int)n / 2) / (int)n;
+        unsigned int dev = 0;
+        for (unsigned int i = 0; i < steps; i++) {
+            if ((sweep[i] >> 4) >= th->ADCLevel) {
+                dev += abs((((sweep[i] & 0x0F) ^ 8) - 8) - mean);
+            }
+        }
+        int spread = constrain((int)((2 * dev + n / 2) / n), TEA5767_IF_SPREAD_MIN, TEA5767_IF_SPREAD_MAX);
+
+        th->IFLow = TEA5767_IF_CENTER + constrain(mean - spread, -TEA5767_IF_SPREAD_MAX, TEA5767_IF_SPREAD_MAX);
+        th->IFHigh = TEA5767_IF_CENTER + constrain(mean + spread, -TEA5767_IF_SPREAD_MAX, TEA5767_IF_SPREAD_MAX);
+    } else {
+        th->IFLow = TEA5767_IF_LOW;
+        th->IFHigh = TEA5767_IF_HIGH;
+    }
+
+    SPT("Threshold - Noise floor : ", noiseFloor);
+    SPT(" - ADC Level : ", th->ADCLevel);
+    SPT(" - IF : ", th->IFLow);
+    SPL(" ~ ", th->IFHigh);
+}
+
+// Keep the best hit of a run of adjacent scan hits
+// higher ADC level wins, IF counter closer to the centre breaks the tie
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::updateScanPeak(TEA5767_ScanPeak *peak, float freq, byte ADCLevel, byte IFCounter, byte injection) {
+    byte IFOffset = abs((int)IFCounter - TEA5767_IF_CENTER);
+
+    if (ADCLevel > peak->ADCLevel || (ADCLevel == peak->ADCLevel && IFOffset < peak->IFOffset)) {
+        peak->freq = freq;
+        peak->ADCLevel = ADCLevel;
+        peak->IFOffset = IFOffset;
+        peak->injection = injection;
+    }
+}
+
+// Add the peak of a run to preset, and reset the peak for the next run
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::addScanPeak(TEA5767_ScanPeak *peak, byte ssl) {
+    byte found = 1;
+
+    if (scanVerifyPeak == TEA5767_SCAN_VERIFY_YES) {
+        // one extra read with the injection measured at the peak
+        status.injection = peak->injection;
+        setSideInjectionMode(status.injection);
+        setFreq(peak->freq);
+
+        I2C_Write();
+        found = readStation(ssl);
+    }
+
+    if (found) {
+        addFreqPreset(peak->freq, peak->injection);
+        SPT("SCAN PEAK - Freq : ", peak->freq);
+        SPT(" - ADC Level : ", peak->ADCLevel);
+        SPL(" - IF Offset : ", peak->IFOffset);
+    } else {
+        SPL("SCAN PEAK - Verify failed : ", peak->freq);
+    }
+
+    *peak = TEA5767_ScanPeak();
+}
+
+// Wait retryPolicy.retryInterval before reading again, never past the deadline of read_status() started at startTime
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::retryWait(unsigned long startTime) {
+    unsigned long elapsed = now() - startTime;  // wrap-safe
+    if (elapsed < retryPolicy.deadline) {
+        wait(min((unsigned long)retryPolicy.retryInterval, retryPolicy.deadline - elapsed));
+    }
+}
+
+// Read rawData from TEA5767, the fields are decoded by TEA5767_Status on demand
+// every failure has its own retry counter in retryPolicy, and the call is bounded by retryPolicy.deadline
+template <class Bus, class Clock>
+byte TEA5767_Driver<Bus, Clock>::read_status() {
+    byte timeoutRetry = retryPolicy.timeoutRetry;
+    byte badDataRetry = retryPolicy.badDataRetry;
+    byte notReadyRetry = retryPolicy.notReadyRetry;
+    unsigned long startTime = now();
+
+    while (1) {
+        unsigned long elapsed = now() - startTime;  // wrap-safe
+        if (elapsed >= retryPolicy.deadline) {
+            SPL("TEA5767 : Read deadline reached.", " ");
+            return TEA5767_DEADLINE;
+        }
+
+        // the last read never runs over the deadline
+        unsigned long timeout = retryPolicy.deadline - elapsed;
+        if (timeout > retryPolicy.readTimeout) {
+            timeout = retryPolicy.readTimeout;
+        }
+
+        if (I2C_Read(timeout) == TEA5767_READ_TIMEOUT) {
+            if (timeoutRetry == 0) {
+                SPL("TEA5767 : Error, please check connection.", " ");
+                return TEA5767_ERROR;
+            }
+            SPL("TEA5767 : I2C Timeout and retry.", " ");
+            timeoutRetry--;
+        } else if (status.PLL() == 0) {  // read again when get wrong data
+            if (badDataRetry == 0) {
+                return TEA5767_BAD_DATA;
+            }
+            badDataRetry--;
+            retryWait(startTime);
+        } else if (status.radioReady() == 0) {
+            // Radio not ready is always because the weak signal
+            // rawData is still valid for IF counter and ADC level
+            if (notReadyRetry == 0) {
+                return TEA5767_NOT_READY;
+            }
+            notReadyRetry--;
+            retryWait(startTime);
+        } else {
+            // SPH("RD1 ", status.rawData[0]);
+            // SPH("RD2 ", status.rawData[1]);
+            // SPH("RD3 ", status.rawData[2]);
+            // SPH("RD4 ", status.rawData[3]);
+            // SPH("RD5 ", status.rawData[4]);
+            return TEA5767_READ_OK;
+        }
+    }
+}
+
+/*
+    Config
+    the following functino didn't send to the device before using I2C_Write()
+    use toggle instead;
+*/
+// if MUTE = 1 then L and R audio are muted; if MUTE = 0 then L and R audio are not muted
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::setMute(byte mute) {
+    setOnOff(&writeData[0], TEA5767_MASK_MUTE, mute);
+    status.Sound_All = mute;
+}
+
+// Search mode: if SM = 1 then in search mode; if SM = 0 then not in search mode
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::setSearchMode(byte mode) {
+    setOnOff(&writeData[0], TEA5767_MASK_SEARCH_MODE, mode);
+}
+
+// Freq. in MHz
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::setFreq(float freq) {
+    writeData[0] &= 0xC0;  // clear PLL bits
+    writeData[1] = 0;
+
+    // Calculate the PLL decimal value
+    // with the crystal error of calibrate()
+    unsigned int PLL_Dec;
+    float xtal = 32.768 * (1 + xtalPPM / 1000000.0);
+
+    if (status.injection == TEA5767_INJECTION_HIGH) {
+        PLL_Dec = round((4 * (freq * 1000 + 225)) / xtal);
+    } else {  // TEA5767_INJECTION_LOW
+        PLL_Dec = round((4 * (freq * 1000 - 225)) / xtal);
+    }
+
+    // put in writeData
+    writeData[0] |= (PLL_Dec >> 8);
+    writeData[1] = PLL_Dec & 0xFF;
+}
+
+// Search Up/Down: if SUD = 1 then search up; if SUD = 0 then search down
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::setSearchDirection(byte dir) {
+    setOnOff(&writeData[2], TEA5767_MASK_SEARCH_DIRECTION, dir);
+    status.dir = dir;
+}
+
+// Search Stop Level : NA in search mode / LOW ADC(5) / MID ADC(7) / HIGH ADC(10)
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::setSearchStopLevel(byte ssl) {
+    byte ssl1, ssl0;
+    switch (ssl) {
+        case TEA5767_SSL_HIGH:
+            ssl1 = 1;
+            ssl0 = 1;
+            break;
+        case TEA5767_SSL_MID:
+            ssl1 = 1;
+            ssl0 = 0;
+            break;
+        case TEA5767_SSL_LOW:
+            ssl1 = 0;
+            ssl0 = 1;
+            break;
+        case TEA5767_SSL_NA:
+            ssl1 = 0;
+            ssl0 = 0;
+            break;
+        default:
+            ssl1 = 1;
+            ssl0 = 1;
+            break;
+    }
+    setOnOff(&writeData[2], TEA5767_MASK_SSL_H, ssl1);
+    setOnOff(&writeData[2], TEA5767_MASK_SSL_L, ssl0);
+}
+
+// High/Low Side Injection: if HLSI = 1 then high side LO injection; if HLSI = 0 then low side LO injection
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::setSideInjectionMode(byte injection) {
+    setOnOff(&writeData[2], TEA5767_MASK_SIDE_INJECTION, injection);
+}
+
+// Mono to Stereo: if MS = 1 then forced mono; if MS = 0 then stereo ON
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::setRadioMode(byte mode) {
+    setOnOff(&writeData[2], TEA5767_MASK_MODE, mode);
+}
+
+// Mute Right: if MR = 1 then the right audio channel is muted and forced mono; if MR = 0 then the right audio channel is not muted
+// Mute Left: if ML = 1 then the left audio channel is muted and forced mono; if ML = 0 then the left audio channel is not muted
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::setMuteChannel(byte channel, byte mute) {
+    if (channel == TEA5767_LEFT) {
+        setOnOff(&writeData[2], TEA5767_MASK_MUTE_LEFT, mute);
+        status.Sound_Left = mute;
+    } else {  // TEA5767_RIGHT
+        setOnOff(&writeData[2], TEA5767_MASK_MUTE_RIGHT, mute);
+        status.Sound_Right = mute;
+    }
+}
+
+// Software programmable port 1: if SWP1 = 1 then port 1 is HIGH; if SWP1 = 0 then port 1 is LOW
+// Software programmable port 2: if SWP2 = 1 then port 2 is HIGH; if SWP2 = 0 then port 2 is LOW
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::setSWP(byte port, byte mode) {
+    if (port == TEA5767_SWP_PORT_1) {
+        setOnOff(&writeData[2], TEA5767_MASK_SWP1, mode);
+    } else {  // TEA5767_RIGHT
+        setOnOff(&writeData[3], TEA5767_MASK_SWP2, mode);
+    }
+}
+
+// Standby: if STBY = 1 then in Standby mode; if STBY = 0 then not in Standby mode
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::setStandby(byte mode) {
+    setOnOff(&writeData[3], TEA5767_MASK_STANDBY, mode);
+}
+
+// JP(76MHz ~ 91MHz) / USEU(87.5MHz ~ 108MHz)
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::setBand(byte band) {
+    setOnOff(&writeData[3], TEA5767_MASK_BAND, band);
+    status.band = band;  // min/max Freq follow the band
+}
+
+// onboard XTAL is 32.768
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::setXTAL() {
+    setOnOff(&writeData[3], TEA5767_MASK_XTAL, 1);
+    setOnOff(&writeData[4], TEA5767_MASK_PLLREF, 0);
+}
+
+// Soft Mute: if SMUTE = 1 then soft mute is ON; if SMUTE = 0 then soft mute is OFF
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::setSoftMute(byte mute) {
+    setOnOff(&writeData[3], TEA5767_MASK_SMUTE, mute);
+    status.SoftMute = mute;
+}
+
+// High Cut Control: if HCC = 1 then high cut control is ON; if HCC = 0 then high cut control is OFF
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::setHighCutControl(byte hcc) {
+    setOnOff(&writeData[3], TEA5767_MASK_HCC, hcc);
+    status.HCC = hcc;
+}
+
+// Stereo Noise Cancelling: if SNC = 1 then stereo noise cancelling is ON; if SNC = 0 then stereo noise cancelling is OFF
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::setStereoNoiseCancelling(byte snc) {
+    setOnOff(&writeData[3], TEA5767_MASK_SNC, snc);
+    status.SNC = snc;
+}
+
+// Search Indicator: if SI = 1 then pin SWPORT1 is output for the ready flag; if SI = 0 then pin SWPORT1 is software programmable port 1
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::setSearchIndicator(byte mode) {
+    setOnOff(&writeData[3], TEA5767_MASK_SEARCH_INDICATOR, mode);
+}
+
+// if DTC = 1 then the de-emphasis time constant is 75 μs; if DTC = 0 then the de-emphasis time constant is 50 μs
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::setDeemphasisTimeConstant(byte dtc) {
+    // https://en.wikipedia.org/wiki/FM_broadcasting
+    // US / Canada / S.Korea = 75us
+    // others = 50 us
+    setOnOff(&writeData[4], TEA5767_MASK_DTC, dtc);
+    status.DTC = dtc;
+}
+
+/**************************
+    public:
+**************************/
+// Put the device in standby mode when temp exit
+// only STBY and mute are changed on writeData, resume() flips them back
+// no IF counter in standby, so no need to wait after write
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::pause() {
+    if (power.standby) {
+        return;
+    }
+
+    power.Sound_All = status.Sound_All;
+
+    setMute(TEA5767_ON);
+    setStandby(TEA5767_ON);
+    setSearchMode(TEA5767_OFF);
+
+    I2C_Write(0);
+
+    power.standby = 1;
+    power.standbySince = now();
+}
+
+// Resume from pause
+// wake on the current writeData by a single write, and poll the ready flag instead of a fixed delay
+template <class Bus, class Clock>
+byte TEA5767_Driver<Bus, Clock>::resume() {
+    if (!power.standby) {
+        return TEA5767_READ_OK;
+    }
+
+    setStandby(TEA5767_OFF);
+    setMute(power.Sound_All);
+
+    unsigned long startTime = now();
+    power.standbyTime += startTime - power.standbySince;
+    power.standby = 0;
+
+    I2C_Write(0);
+
+    // relocked on the previous channel ?
+    unsigned int PLL_Dec = ((writeData[0] & 0x3F) << 8) + writeData[1];
+    byte result;
+    while (1) {
+        result = read_status();
+        if (result == TEA5767_READ_OK && status.PLL() != PLL_Dec) {
+            result = TEA5767_NOT_READY;
+        }
+        if (result == TEA5767_READ_OK || result == TEA5767_ERROR || now() - startTime >= power.wakeTimeout) {
+            break;
+        }
+        wait(1);
+    }
+
+    power.wakeLatency = now() - startTime;
+    power.wakeResult = result;
+    power.wakeCount++;
+
+    return result;
+}
+
+// User activity, e.g. screen wake up
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::touch() {
+    resume();
+    power.lastActivity = now();
+}
+
+// Auto standby after power.idleTimeout without I2C_Write()
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::powerProcess() {
+    if (power.idleTimeout != 0 && !power.standby && now() - power.lastActivity >= power.idleTimeout) {
+        SPL("TEA5767 : Idle, standby.", " ");
+        pause();
+    }
+}
+
+template <class Bus, class Clock>
+unsigned long TEA5767_Driver<Bus, Clock>::standbyTime() {
+    return power.standbyTime + (power.standby ? now() - power.standbySince : 0);
+}
+
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::printStatus() {
+    SPH("RAW DATA 0 : 0x", status.rawData[0]);
+    SPH("RAW DATA 1 : 0x", status.rawData[1]);
+    SPH("RAW DATA 2 : 0x", status.rawData[2]);
+    SPH("RAW DATA 3 : 0x", status.rawData[3]);
+    SPH("RAW DATA 4 : 0x", status.rawData[4]);
+
+    SPL("-------------------", " ");
+    SPL("Radio Ready : ", status.radioReady());
+    SPL("Band : ", status.band);
+    SPL("Min. Freq. : ", status.minFreq());
+    SPL("Max. Freq. : ", status.maxFreq());
+
+    SPL("-------------------", " ");
+    SPL("Radio Mode : ", status.radioMode());
+    SPL("Current Freq. : ", currentFreq());
+    SPL("ADC Level : ", status.ADCLevel());
+    SPL("Injection : ", status.injection);
+
+    SPL("-------------------", " ");
+    SPL("Module Mute : ", status.Sound_All);
+    SPL("Left Mute : ", status.Sound_Left);
+    SPL("Right Mute : ", status.Sound_Right);
+
+    SPL("-------------------", " ");
+    SPL("High Cut Control : ", status.HCC);
+    SPL("Stereo Noise Cancelling : ", status.SNC);
+    SPL("Soft Mute : ", status.SoftMute);
+    SPL("De-emphasis Time Constant : ", status.DTC);
+
+    SPL("-------------------", " ");
+    SPL("# of preset Freq. : ", presetFreqSize);
+}
+
+// Set Station with input freq.
+// The freq is in MHz
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::setStation(float freq) {
+    resume();  // no tuning on a sleeping chip
+
+    setMute(TEA5767_MUTE_OFF);
+    setSearchMode(TEA5767_OFF);
+
+    // perform HILO injection optimal here
+    optimalSideInjection(freq);
+
+    // set freq with optimal result
+    setSideInjectionMode(status.injection);
+    setFreq(freq);
+
+    I2C_Write();
+    read_status();
+
+    SPT("SET - IF : ", status.IFCounter());
+    SPT(" Set Freq : ", freq);
+    SPT(" - Optimized to : ", currentFreq());
+    SPT(" - ADC Level : ", status.ADCLevel());
+    SPL(" - Side Injection : ", status.injection);
+}
+
+// Crystal calibration
+// tune each known strong station, the IF counter deviation from TEA5767_IF_CENTER is the LO error
+// high side injection : IF = LO - Freq, low side injection : IF = Freq - LO
+// LO error = LO * ppm, fitted by least squares and added to the current correction
+// a coarse pass accepts any IF counter up to TEA5767_CAL_PPM_MAX, the fine pass then rejects adjacent channels
+template <class Bus, class Clock>
+byte TEA5767_Driver<Bus, Clock>::calibrate(const float *freqs, byte count) {
+    resume();
+
+    byte mute = status.Sound_All;
+
+    setMute(TEA5767_MUTE_ON);
+    setSearchMode(TEA5767_OFF);
+
+    byte used = calibratePass(freqs, count, TEA5767_CAL_IF_COARSE);
+    if (used > 0) {
+        byte fine = calibratePass(freqs, count, TEA5767_CAL_IF_RANGE);
+        if (fine > 0) {
+            used = fine;
+        }
+    }
+    SPL("CAL - XTAL ppm : ", xtalPPM);
+
+    setMute(mute);
+    I2C_Write();
+
+    return used;
+}
+
+template <class Bus, class Clock>
+byte TEA5767_Driver<Bus, Clock>::calibratePass(const float *freqs, byte count, byte range) {
+    float num = 0, den = 0;
+    byte used = 0;
+
+    for (byte i = 0; i < count; i++) {
+        // perform HILO injection optimal here
+        optimalSideInjection(freqs[i]);
+
+        // set freq with optimal result
+        setSideInjectionMode(status.injection);
+        setFreq(freqs[i]);
+        I2C_Write();
+
+        // average the IF counter, a new count every ~28ms
+        int sumIF = 0;
+        byte reads = 0;
+        for (byte r = 0; r < TEA5767_CAL_READS; r++) {
+            if (r > 0) {
+                wait(35);
+            }
+            byte result = read_status();
+            if ((result == TEA5767_READ_OK || result == TEA5767_NOT_READY) && status.ADCLevel() >= TEA5767_SSL_MID &&
+                abs((int)status.IFCounter() - TEA5767_IF_CENTER) <= range) {
+                sumIF += status.IFCounter() - TEA5767_IF_CENTER;
+                reads++;
+            }
+        }
+
+        if (reads == 0) {
+            SPL("CAL - Skip, weak station : ", freqs[i]);
+            continue;
+        }
+
+        float LO = (status.injection == TEA5767_INJECTION_HIGH) ? freqs[i] * 1000000 + 225000 : freqs[i] * 1000000 - 225000;
+        float error = (float)sumIF / reads * TEA5767_IF_STEP;  // Hz
+        if (status.injection == TEA5767_INJECTION_LOW) {
+            error = -error;
+        }
+        num += error * LO;
+        den += LO * LO;
+        used++;
+
+        SPT("CAL - Freq : ", freqs[i]);
+        SPT(" - IF Offset : ", (float)sumIF / reads);
+        SPL(" - Side Injection : ", status.injection);
+    }
+
+    if (used > 0) {
+        long ppm = xtalPPM + lround(num / den * 1000000);
+        xtalPPM = constrain(ppm, -TEA5767_CAL_PPM_MAX, TEA5767_CAL_PPM_MAX);
+    }
+
+    return used;
+}
+
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::searchStation(byte dir, byte ssl) {
+    resume();
+
+    setMute(TEA5767_MUTE_ON);
+    setSearchMode(TEA5767_OFF);
+
+    searchProcessStatus = TEA5767_SEARCH_PENDING;
+    status.dir = dir;
+    status.ssl = ssl;
+
+    SPL("Search - From : ", searchingFreq);
+
+    searchProcess();
+}
+
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::searchProcess() {
+    if (power.standby) {
+        return;  // continued after resume()
+    }
+
+    searchProcessStatus = TEA5767_SEARCH_PENDING;
+
+    if (status.dir  == TEA5767_UP && searchingFreq > status.maxFreq()) {
+        searchingFreq = status.minFreq();
+        SPL("Max Freq. reached. Loop Stop and reset to Min Freq.", " ");
+        searchProcessStatus = TEA5767_SEARCH_STOP;
+    }
+    if (status.dir  == TEA5767_DOWN && searchingFreq < status.minFreq()) {
+        searchingFreq = status.maxFreq();
+        SPL("Min Freq. reached. Loop Stop and reset to Max Freq.", " ");
+        searchProcessStatus = TEA5767_SEARCH_STOP;
+    }
+
+    if ( searchProcessStatus != TEA5767_SEARCH_STOP ) {
+        // Searching next freq
+        searchingFreq += (status.dir  == TEA5767_UP) ? 0.1 : -0.1;
+
+        // perform HILO injection optimal here
+        optimalSideInjection(searchingFreq);
+
+        // set freq with optimal result
+        setSideInjectionMode(status.injection);
+        setFreq(searchingFreq);
+
+        I2C_Write();
+        read_status();
+        
+        // Good Signal
+        if (isStation(status.ssl)) {
+            if ( searchPreset ==  TEA5767_SEARCH_PRESET_YES ) {
+                addFreqPreset(searchingFreq, status.injection);
+                SPT(" SEARCH - IF : ", status.IFCounter());
+                SPT(" Set Freq : ", searchingFreq);
+                SPT(" - Optimized to : ", currentFreq());
+                SPT(" - ADC Level : ", status.ADCLevel());
+                SPL(" - Side Injection : ", status.injection);
+            }
+            SPL("Station Found."," ");
+
+            setStation(searchingFreq);
+            searchProcessStatus = TEA5767_SEARCH_COMPLETE;
+        }
+    }
+}
+
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::scanStation(byte ssl) {
+    resume();
+
+    setMute(TEA5767_MUTE_ON);
+    setSearchMode(TEA5767_OFF);
+    setSearchIndicator(TEA5767_OFF);
+
+    // one byte per step : ADC level [7:4], IF counter offset [3:0], and 1 bit per step of injection
+    unsigned int steps = (status.maxChannel() - status.minChannel()) / 10;
+    byte *sweep = (byte *)malloc(steps);
+    byte *sweepInjection = (byte *)calloc((steps + 7) / 8, 1);
+    if (sweep == NULL || sweepInjection == NULL) {
+        free(sweep);
+        free(sweepInjection);
+        SPL("Scan : not enough memory.", " ");
+        return;
+    }
+
+    TEA5767_ScanPeak peak;
+    byte inRun = 0;  // 1 if the previous step is a hit
+
+    // reset freq
+    presetFreqSize = 0;
+    free(preset);
+    preset = NULL;
+    curPreset = 0;
+
+    SPL("Start Scanning...", " ");
+    for (unsigned int i = 0; i < steps; i++) {
+        float freq = status.minFreq() + i * TEA5767_SCAN_STEP;
+
+        // perform HILO injection optimal here
+        optimalSideInjection(freq);
+
+        // set freq with optimal result
+        setSideInjectionMode(status.injection);
+        setFreq(freq);
+
+        I2C_Write();
+        byte result = read_status();
+
+        // a failed read keeps rawData of the previous step, so nothing heard here
+        int IFOffset = constrain((int)status.IFCounter() - TEA5767_IF_CENTER, -8, 7);
+        byte ADCLevel = (result == TEA5767_READ_OK || result == TEA5767_NOT_READY) ? status.ADCLevel() : 0;
+        sweep[i] = (ADCLevel << 4) | (IFOffset & 0x0F);
+        if (status.injection == TEA5767_INJECTION_HIGH) {
+            bit_set(sweepInjection[i / 8], i % 8);
+        }
+    }
+
+    if (adaptiveThreshold == TEA5767_ON) {
+        measureThreshold(sweep, steps);
+    }
+
+    for (unsigned int i = 0; i < steps; i++) {
+        float freq = status.minFreq() + i * TEA5767_SCAN_STEP;
+        byte ADCLevel = sweep[i] >> 4;
+        byte IFCounter = TEA5767_IF_CENTER + ((sweep[i] & 0x0F) ^ 8) - 8;
+        byte injection = (sweepInjection[i / 8] >> (i % 8)) & 1;
+
+        // Good Signal, group adjacent hits and keep the peak only
+        if (isStation(ssl, ADCLevel, IFCounter)) {
+            SPT("SCAN IF : ", IFCounter);
+            SPT(" Set Freq : ", freq);
+            SPT(" - ADC Level : ", ADCLevel);
+            SPL(" - Side Injection : ", injection);
+
+            updateScanPeak(&peak, freq, ADCLevel, IFCounter, injection);
+            inRun = 1;
+        } else if (inRun) {
+            addScanPeak(&peak, ssl);
+            inRun = 0;
+        }
+    }
+
+    // run reaching the band limit
+    if (inRun) {
+        addScanPeak(&peak, ssl);
+    }
+
+    free(sweep);
+    free(sweepInjection);
+
+    SPL("Scan completed.", " ");
+    setMute(TEA5767_MUTE_OFF);
+    I2C_Write();
+}
+
+// Re-check every preset with a single write of its cached injection
+// the side injection is searched again only when the check fails,
+// and a preset failing TEA5767_RESCAN_FAILS times in a row is removed
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::rescanStation(byte ssl) {
+    resume();
+
+    byte image[5];
+    for (byte i = 0; i < 5; i++) {
+        image[i] = writeData[i];
+    }
+    float cur = presetAt(curPreset);
+
+    setMute(TEA5767_MUTE_ON);
+    setSearchMode(TEA5767_OFF);
+    status.ssl = ssl;
+
+    SPL("Start Rescanning...", " ");
+    int i = 0;
+    while (i < presetFreqSize) {
+        tunePreset(i);
+        byte found = readStation(ssl);
+
+        if (!found) {
+            // injection may have changed
+            optimalSideInjection(preset[i].freq);
+            setSideInjectionMode(status.injection);
+            setFreq(preset[i].freq);
+            I2C_Write();
+            found = readStation(ssl);
+            if (found) {
+                preset[i].injection = status.injection;
+            }
+        }
+
+        if (found) {
+            preset[i].fails = 0;
+            i++;
+        } else if (++preset[i].fails >= TEA5767_RESCAN_FAILS) {
+            SPL("RESCAN - Removed : ", preset[i].freq);
+            removePreset(i);
+        } else {
+            SPT("RESCAN - Failed : ", preset[i].freq);
+            SPL(" - Times : ", preset[i].fails);
+            i++;
+        }
+    }
+
+    int c = findPreset(cur);
+    curPreset = (c >= 0) ? c : 0;
+
+    // discovery continues in rescanProcess()
+    rescanCursor = 0;
+    rescanOffset = (rescanOffset + 1) % TEA5767_RESCAN_STRIDE;
+    rescanStatus = TEA5767_SEARCH_PENDING;
+
+    restoreImage(image);
+    rescanLast = now();
+}
+
+// Sample a channel for a new station, keep the peak of it and its neighbours
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::rescanSample(float freq, byte ssl) {
+    TEA5767_ScanPeak peak;
+
+    // quick look by a single write, the side injection is only searched on a hit
+    status.injection = TEA5767_INJECTION_HIGH;
+    setSideInjectionMode(status.injection);
+    setFreq(freq);
+    I2C_Write();
+    if (!readStation(ssl)) {
+        return;
+    }
+
+    for (int d = 0; d <= 2; d++) {
+        // freq first, then the neighbours only if freq is a hit
+        float f = freq + ((d == 0) ? 0 : (d == 1) ? -TEA5767_SCAN_STEP : TEA5767_SCAN_STEP);
+        if (f < status.minFreq() || f >= status.maxFreq() || (d > 0 && findPreset(f) >= 0)) {
+            continue;
+        }
+
+        // perform HILO injection optimal here
+        optimalSideInjection(f);
+
+        // set freq with optimal result
+        setSideInjectionMode(status.injection);
+        setFreq(f);
+        I2C_Write();
+
+        if (readStation(ssl)) {
+            updateScanPeak(&peak, f, status.ADCLevel(), status.IFCounter(), status.injection);
+        } else if (d == 0) {
+            return;
+        }
+    }
+
+    if (findPreset(peak.freq) < 0) {
+        addScanPeak(&peak, ssl);
+    }
+}
+
+// Discovery of new stations after rescanStation(), steps channels per batch, at most one batch per rescanInterval
+// a station passes the test at 2-3 neighbouring steps, so only every TEA5767_RESCAN_STRIDE channel is sampled,
+// the other channels are sampled by the next rescan. Channels next to a preset are skipped
+template <class Bus, class Clock>
+byte TEA5767_Driver<Bus, Clock>::rescanProcess(byte steps) {
+    if (rescanStatus != TEA5767_SEARCH_PENDING) {
+        return rescanStatus;
+    }
+    if (power.standby) {
+        return rescanStatus;  // no discovery in standby, continued after resume()
+    }
+    // one batch per rescanInterval while the sound is on, a short gap now and then instead of a stutter
+    if (status.Sound_All == TEA5767_MUTE_OFF && now() - rescanLast < rescanInterval) {  // wrap-safe
+        return rescanStatus;
+    }
+
+    unsigned int total = (status.maxChannel() - status.minChannel()) / 10;
+    unsigned int passLen = (total + TEA5767_RESCAN_STRIDE - 1) / TEA5767_RESCAN_STRIDE;
+
+    byte image[5];
+    for (byte i = 0; i < 5; i++) {
+        image[i] = writeData[i];
+    }
+    float cur = presetAt(curPreset);
+
+    setMute(TEA5767_MUTE_ON);
+    setSearchMode(TEA5767_OFF);
+
+    byte n = 0;
+    while (n < steps && rescanCursor < passLen) {
+        unsigned int i = rescanCursor * TEA5767_RESCAN_STRIDE + rescanOffset;
+        float freq = status.minFreq() + i * TEA5767_SCAN_STEP;
+        rescanCursor++;
+
+        if (i >= total || findPreset(freq) >= 0) {
+            continue;
+        }
+        rescanSample(freq, status.ssl);
+        n++;
+    }
+
+    if (rescanCursor >= passLen) {
+        SPL("Rescan completed.", " ");
+        rescanStatus = TEA5767_SEARCH_COMPLETE;
+    }
+
+    int c = findPreset(cur);
+    curPreset = (c >= 0) ? c : 0;
+
+    restoreImage(image);
+    rescanLast = now();
+    return rescanStatus;
+}
+
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::nextPreset() {
+    resume();
+
+    if (presetFreqSize > 0) {  // preset present
+        curPreset++;
+        if (curPreset >= presetFreqSize) {
+            curPreset = 0;
+        }
+        tunePreset(curPreset);
+        SPT("Next : Preset[", curPreset);
+        SPT("/", presetFreqSize);
+        SPL("] : ", String(preset[curPreset].freq));
+    }
+}
+
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::prevPreset() {
+    resume();
+
+    if (presetFreqSize > 0) {  // preset present
+        curPreset--;
+        if (curPreset < 0) {
+            curPreset = presetFreqSize - 1;
+        }
+        tunePreset(curPreset);
+        SPT("Prev : Preset[", curPreset);
+        SPT("/", presetFreqSize);
+        SPL("] : ", String(preset[curPreset].freq));
+    }
+}
+
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::printPreset() {
+    SPL("----- Preset List -----", " ");
+    for (int i = 0; i < presetFreqSize; i++) {
+        SPT("[", i);
+        SPT(" - ", preset[i].freq);
+        SPT("]", " ");
+    }
+    SPL("--- total : ", presetFreqSize);
+    SPL("Current Preset : ", curPreset);
+    SPT("Threshold - ADC Level : ", threshold[status.band].ADCLevel);
+    SPT(" - IF : ", threshold[status.band].IFLow);
+    SPL(" ~ ", threshold[status.band].IFHigh);
+    SPL("-----", " ");
+}
+
+template <class Bus, class Clock>
+unsigned int TEA5767_Driver<Bus, Clock>::savePreset(byte *buf, unsigned int len) {
+    if (len < presetDataSize()) {
+        return 0;
+    }
+
+    buf[0] = presetFreqSize & 0xFF;
+    buf[1] = presetFreqSize >> 8;
+    for (byte b = 0; b < 2; b++) {
+        buf[2 + b * 3] = threshold[b].ADCLevel;
+        buf[3 + b * 3] = threshold[b].IFLow;
+        buf[4 + b * 3] = threshold[b].IFHigh;
+    }
+    buf[8] = xtalPPM & 0xFF;
+    buf[9] = (xtalPPM >> 8) & 0xFF;
+
+    for (int i = 0; i < presetFreqSize; i++) {
+        unsigned int channel = round(preset[i].freq * 100);
+        channel |= preset[i].injection << 15;
+        buf[TEA5767_PRESET_HEADER + i * 2] = channel & 0xFF;
+        buf[TEA5767_PRESET_HEADER + i * 2 + 1] = channel >> 8;
+    }
+
+    return presetDataSize();
+}
+
+template <class Bus, class Clock>
+byte TEA5767_Driver<Bus, Clock>::loadPreset(const byte *buf, unsigned int len) {
+    if (len < TEA5767_PRESET_HEADER) {
+        return 0;
+    }
+
+    int count = buf[0] + (buf[1] << 8);
+    if (len < TEA5767_PRESET_HEADER + (unsigned int)count * 2) {
+        return 0;
+    }
+
+    for (byte b = 0; b < 2; b++) {
+        threshold[b].ADCLevel = buf[2 + b * 3];
+        threshold[b].IFLow = buf[3 + b * 3];
+        threshold[b].IFHigh = buf[4 + b * 3];
+    }
+    xtalPPM = (int16_t)(buf[8] + (buf[9] << 8));
+
+    presetFreqSize = 0;
+    free(preset);
+    preset = NULL;
+    for (int i = 0; i < count; i++) {
+        unsigned int channel = buf[TEA5767_PRESET_HEADER + i * 2] + (buf[TEA5767_PRESET_HEADER + i * 2 + 1] << 8);
+        addFreqPreset((channel & 0x7FFF) / 100.0, channel >> 15);
+    }
+    curPreset = 0;
+
+    return 1;
+}
+
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::deleteCurFreqPreset() {
+    resume();
+
+    removePreset(curPreset);
+
+    if (presetFreqSize != 0) {
+        setStation(preset[curPreset].freq);
+    }
+}
+
+/*
+    Toggle
+    update device with specific flag
+*/
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::toggleMute(byte channel) {
+    resume();
+
+    switch (channel) {
+        case TEA5767_LEFT:
+            setMuteChannel(TEA5767_LEFT, (status.Sound_Left) ? TEA5767_MUTE_OFF : TEA5767_MUTE_ON);
+            SPL("Mute Left : ", status.Sound_Left);
+            break;
+        case TEA5767_RIGHT:
+            setMuteChannel(TEA5767_RIGHT, (status.Sound_Right) ? TEA5767_MUTE_OFF : TEA5767_MUTE_ON);
+            SPL("Mute Right: ", status.Sound_Right);
+            break;
+        case TEA5767_ALL:
+            setMute((status.Sound_All) ? TEA5767_MUTE_OFF : TEA5767_MUTE_ON);
+            SPL("Mute All: ", status.Sound_All);
+            break;
+    }
+    I2C_Write();
+}
+
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::toggleSoftMute() {
+    resume();
+
+    setSoftMute((status.SoftMute) ? TEA5767_MUTE_OFF : TEA5767_MUTE_ON);
+    SPL("SoftMute: ", status.SoftMute);
+    I2C_Write();
+}
+
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::toggleHighCutControl() {
+    resume();
+
+    setHighCutControl((status.HCC) ? TEA5767_OFF : TEA5767_ON);
+    SPL("HCC: ", status.HCC);
+    I2C_Write();
+}
+
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::toggleStereoNoiseCancelling() {
+    resume();
+
+    setStereoNoiseCancelling((status.SNC) ? TEA5767_OFF : TEA5767_ON);
+    SPL("SNC: ", status.SNC);
+    I2C_Write();
+}
+
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::toggleDeemphasisTimeConstant() {
+    resume();
+
+    setDeemphasisTimeConstant((status.DTC) ? TEA5767_DTC_50US : TEA5767_DTC_75US);
+    SPL("DTC: ", status.DTC);
+    I2C_Write();
+}
+
+template <class Bus, class Clock>
+void TEA5767_Driver<Bus, Clock>::toggleMode() {
+    resume();
+
+    setRadioMode((status.radioMode()) ? TEA5767_STEREO : TEA5767_MONO);
+    SPL("Mode: ", status.radioMode());
+    I2C_Write();
+}
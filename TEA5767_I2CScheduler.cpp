@@ -0,0 +1,240 @@
+/*
+	Project  : LaLiMat project (https://www.youtube.com/playlist?list=PLJBKmE2nNweRXOebZjydkMEiq2pHtBMOS in Chinese)
+ 	file     : TEA5767_I2CScheduler.cpp
+	Author   : ykchau
+ 	youtube  : youtube.com/ykchau888
+  	Licenese : GPL-3.0
+   	Please let me know if you use it commercial project.
+*/
+#include "TEA5767_I2CScheduler.h"
+
+TEA5767_I2CScheduler::TEA5767_I2CScheduler(TEA5767_SchedDevice *device, byte deviceMax, TEA5767_SchedEntry *queue, byte queueMax)
+    : device(device), deviceMax(deviceMax), queue(queue), queueMax(queueMax) {
+    periodStart = micros();
+    statStart = millis();
+}
+
+// before the tasks start
+byte TEA5767_I2CScheduler::addDevice(byte priority, unsigned long budget) {
+    if (deviceCount >= deviceMax) {
+        return TEA5767_ERROR;
+    }
+    device[deviceCount].priority = priority;
+    device[deviceCount].budget = budget;
+    return deviceCount++;
+}
+
+// Refill the budgets at the start of every period
+void TEA5767_I2CScheduler::refill() {
+    if (micros() - periodStart >= TEA5767_SCHED_PERIOD * 1000UL) {  // wrap-safe
+        periodStart = micros();
+        for (byte i = 0; i < deviceCount; i++) {
+            device[i].used = 0;
+        }
+    }
+}
+
+bool TEA5767_I2CScheduler::inBudget(byte dev) {
+    return device[dev].budget == 0 || device[dev].used < device[dev].budget;
+}
+
+// Queued job of priority < below, in budget and fit in window us, under lock
+// Highest priority first, the oldest one of the same priority first
+int TEA5767_I2CScheduler::next(byte below, unsigned long window) {
+    unsigned long now = micros();
+    int best = -1;
+
+    for (byte i = 0; i < queueCount; i++) {
+        TEA5767_SchedEntry *e = &queue[i];
+        byte priority = device[e->device].priority;
+
+        if (priority >= below || e->cost > window) {
+            continue;
+        }
+        if (!inBudget(e->device)) {
+            if (!e->held) {
+                e->held = 1;
+                device[e->device].overBudget++;
+            }
+            continue;
+        }
+        if (best < 0 || priority < device[queue[best].device].priority ||
+            (priority == device[queue[best].device].priority && now - e->queued > now - queue[best].queued)) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+// Remove the next job from the queue, it runs after unlock
+bool TEA5767_I2CScheduler::take(byte below, unsigned long window, TEA5767_SchedEntry *e) {
+    lock.lock();
+    int i = next(below, window);
+    if (i >= 0) {
+        *e = queue[i];
+        queue[i] = queue[--queueCount];
+    }
+    lock.unlock();
+    return i >= 0;
+}
+
+// Add us to a ms total, the remainder is kept in us
+void TEA5767_I2CScheduler::addUs(unsigned long &ms, unsigned int &us, unsigned long add) {
+    us += add % 1000;
+    ms += add / 1000 + us / 1000;
+    us %= 1000;
+}
+
+byte TEA5767_I2CScheduler::execute(byte dev, TEA5767_SchedJob job, void *arg, unsigned long queued) {
+    unsigned long start = micros();
+    unsigned long waited = start - queued;
+    byte result = job(arg);
+    unsigned long busy = micros() - start;
+
+    TEA5767_SchedDevice *d = &device[dev];
+    d->jobs++;
+    addUs(d->busy, d->busyUs, busy);
+    d->used += busy;
+    addUs(d->queueDelay, d->queueDelayUs, waited);
+    if (waited > d->maxQueueDelay) {
+        d->maxQueueDelay = waited;
+    }
+    return result;
+}
+
+// any task
+bool TEA5767_I2CScheduler::submit(byte dev, TEA5767_SchedJob job, void *arg, unsigned int cost) {
+    if (dev >= deviceCount) {
+        return false;
+    }
+    unsigned long queued = micros();
+
+    lock.lock();
+    bool ok = queueCount < queueMax;
+    if (ok) {
+        TEA5767_SchedEntry *e = &queue[queueCount++];
+        e->job = job;
+        e->arg = arg;
+        e->device = dev;
+        e->cost = cost;
+        e->queued = queued;
+        e->held = 0;
+    }
+    lock.unlock();
+    return ok;
+}
+
+byte TEA5767_I2CScheduler::pending() {
+    lock.lock();
+    byte n = queueCount;
+    lock.unlock();
+    return n;
+}
+
+// Blocking transaction of dev, e.g. the tuner
+// The queued jobs of higher priority go first, and dev waits for the next period if it is over budget
+byte TEA5767_I2CScheduler::run(byte dev, TEA5767_SchedJob job, void *arg) {
+    unsigned long queued = micros();
+
+    refill();
+    if (!inBudget(dev)) {
+        device[dev].overBudget++;
+        while (!inBudget(dev)) {
+            unsigned long left = TEA5767_SCHED_PERIOD * 1000UL - (micros() - periodStart);
+            wait(left / 1000 + 1);
+            refill();
+        }
+    }
+
+    // only the jobs queued before, a job may submit the next one
+    byte n = pending();
+    TEA5767_SchedEntry e;
+    while (n-- > 0 && take(device[dev].priority, 0xFFFFFFFF, &e)) {
+        execute(e.device, e.job, e.arg, e.queued);
+    }
+
+    return execute(dev, job, arg, queued);
+}
+
+byte TEA5767_I2CScheduler::service(unsigned long window) {
+    unsigned long start = micros();
+    byte done = 0;
+    TEA5767_SchedEntry e;
+
+    refill();
+    while (take(0xFF, window - (micros() - start), &e)) {
+        execute(e.device, e.job, e.arg, e.queued);
+        done++;
+
+        if (micros() - start >= window) {
+            break;
+        }
+    }
+    return done;
+}
+
+void TEA5767_I2CScheduler::wait(unsigned long ms) {
+    unsigned long start = micros();
+    unsigned long window = ms * 1000;
+
+    while (micros() - start < window) {  // wrap-safe
+        unsigned long left = window - (micros() - start);
+        if (service(left) == 0) {
+            if (left >= 1000) {
+                ::delay(1);
+            } else {
+                delayMicroseconds(left);
+                break;
+            }
+        }
+    }
+}
+
+/**************************
+    Statistics
+**************************/
+// all in ms, millis() wraps after ~49 days instead of ~71 minutes of micros()
+float TEA5767_I2CScheduler::utilisation() {
+    float busy = 0;
+    for (byte i = 0; i < deviceCount; i++) {
+        busy += device[i].busy + device[i].busyUs / 1000.0;
+    }
+    unsigned long elapsed = millis() - statStart;
+    return elapsed ? busy * 100 / elapsed : 0;
+}
+
+float TEA5767_I2CScheduler::utilisation(byte dev) {
+    unsigned long elapsed = millis() - statStart;
+    return elapsed ? (device[dev].busy + device[dev].busyUs / 1000.0) * 100 / elapsed : 0;
+}
+
+unsigned long TEA5767_I2CScheduler::avgQueueDelay(byte dev) {
+    return device[dev].jobs ? (device[dev].queueDelay * 1000.0 + device[dev].queueDelayUs) / device[dev].jobs : 0;
+}
+
+void TEA5767_I2CScheduler::printStats() {
+    SPL("Bus utilisation % : ", utilisation());
+    for (byte i = 0; i < deviceCount; i++) {
+        SPT("Device ", i);
+        SPT(" priority ", device[i].priority);
+        SPT(" jobs ", device[i].jobs);
+        SPT(" busy % ", utilisation(i));
+        SPT(" avg delay us ", avgQueueDelay(i));
+        SPT(" max delay us ", device[i].maxQueueDelay);
+        SPL(" over budget ", device[i].overBudget);
+    }
+    SPL("Pending : ", pending());
+}
+
+void TEA5767_I2CScheduler::resetStats() {
+    for (byte i = 0; i < deviceCount; i++) {
+        device[i].jobs = 0;
+        device[i].busy = 0;
+        device[i].queueDelay = 0;
+        device[i].busyUs = 0;
+        device[i].queueDelayUs = 0;
+        device[i].maxQueueDelay = 0;
+        device[i].overBudget = 0;
+    }
+    statStart = millis();
+}
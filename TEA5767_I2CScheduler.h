@@ -0,0 +1,199 @@
+/*
+	Project  : LaLiMat project (https://www.youtube.com/playlist?list=PLJBKmE2nNweRXOebZjydkMEiq2pHtBMOS in Chinese)
+ 	file     : TEA5767_I2CScheduler.h
+	Author   : ykchau
+ 	youtube  : youtube.com/ykchau888
+  	Licenese : GPL-3.0
+   	Please let me know if you use it commercial project.
+*/
+
+/*
+    Shared I2C bus scheduler
+    - Transactions of every device on the bus are queued by priority (0 = highest)
+    - Each device can have a budget of bus time per TEA5767_SCHED_PERIOD
+    - The tuner's settle windows (delay after a write, poll of the ready flag) service the queue instead of blocking
+    - Bus utilisation and queueing delay per device, kept in ms so they don't wrap with micros() after ~71 minutes
+
+    Threads (ESP32/FreeRTOS, Linux) :
+    - submit() and pending() from any task, the queue is guarded by TEA5767_SchedLock
+    - run(), service(), wait() and the statistics from the task owning the bus (the tuner's task), the jobs run there
+    - other Arduino boards have a single loop(), no lock, so no submit() from an interrupt
+
+    e.g.
+        TEA5767_I2CSchedulerBuffer<> sched;          // TEA5767_SCHED_DEVICES devices, TEA5767_SCHED_QUEUE queued jobs
+        byte display = sched.addDevice(0);          // display refresh first
+        byte tuner = sched.addDevice(1, 20000);     // tuner, 20ms of bus time per period
+        TEA5767_Driver<TEA5767_SchedBus<>, TEA5767_SchedClock> radio(TEA5767_SchedBus<>(sched, tuner), TEA5767_SchedClock(sched));
+
+        byte flush(void *arg) { ... one I2C transaction of the display ... }
+        sched.submit(display, flush, &oled, 1500);  // estimated 1500us on the bus
+        sched.service();                            // in loop(), run what is queued
+*/
+
+#ifndef TEA5767_I2CSCHEDULER_H_
+#define TEA5767_I2CSCHEDULER_H_
+
+#include "TEA5767.h"
+
+#if defined(ESP32)
+#include <freertos/FreeRTOS.h>
+#elif !defined(ARDUINO)
+#include <mutex>
+#endif
+
+#define TEA5767_SCHED_DEVICES   4       // default devices on the bus of TEA5767_I2CSchedulerBuffer
+#define TEA5767_SCHED_QUEUE     8       // default queued transactions of all devices
+#define TEA5767_SCHED_PERIOD    100     // ms, the budgets are refilled every period
+#define TEA5767_SCHED_COST      600     // us, a 5 bytes transfer at 100KHz
+
+// One I2C transaction, returns the result of endTransmission() / requestFrom()
+typedef byte (*TEA5767_SchedJob)(void *arg);
+
+typedef struct TEA5767_SchedDevice {
+    byte priority = 0;          // 0 = highest
+    unsigned long budget = 0;   // us of bus time per period, 0 = no limit
+    unsigned long used = 0;     // us used in this period
+
+    // statistics
+    unsigned long jobs = 0;
+    unsigned long busy = 0;           // ms on the bus
+    unsigned long queueDelay = 0;     // ms waited, total
+    unsigned int busyUs = 0;          // us below the ms of busy
+    unsigned int queueDelayUs = 0;    // us below the ms of queueDelay
+    unsigned long maxQueueDelay = 0;  // us
+    unsigned long overBudget = 0;     // jobs held back by the budget, run() and queued
+} TEA5767_SchedDevice;
+
+typedef struct TEA5767_SchedEntry {
+    TEA5767_SchedJob job;
+    void *arg;
+    byte device;
+    unsigned int cost;     // estimated us on the bus
+    unsigned long queued;  // micros() of submit()
+    byte held;             // counted in overBudget
+} TEA5767_SchedEntry;
+
+// Short critical section around the queue, never held while a job is on the bus
+#if defined(ESP32)
+class TEA5767_SchedLock {
+   private:
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+
+   public:
+    void lock() { portENTER_CRITICAL(&mux); }
+    void unlock() { portEXIT_CRITICAL(&mux); }
+};
+#elif !defined(ARDUINO)
+class TEA5767_SchedLock {
+   private:
+    std::mutex mutex;
+
+   public:
+    void lock() { mutex.lock(); }
+    void unlock() { mutex.unlock(); }
+};
+#else
+class TEA5767_SchedLock {
+   public:
+    void lock() {}
+    void unlock() {}
+};
+#endif
+
+// Devices and queue live in TEA5767_I2CSchedulerBuffer (or any caller arrays), the scheduler only keeps pointers
+class TEA5767_I2CScheduler {
+   private:
+    TEA5767_SchedDevice *device;
+    byte deviceMax;
+    byte deviceCount = 0;
+    TEA5767_SchedEntry *queue;
+    byte queueMax;
+    byte queueCount = 0;
+    TEA5767_SchedLock lock;
+    unsigned long periodStart;
+    unsigned long statStart;  // millis()
+
+    void refill();
+    bool inBudget(byte dev);
+    int next(byte priority, unsigned long window);
+    bool take(byte priority, unsigned long window, TEA5767_SchedEntry *e);
+    byte execute(byte dev, TEA5767_SchedJob job, void *arg, unsigned long queued);
+    static void addUs(unsigned long &ms, unsigned int &us, unsigned long add);
+
+   public:
+    TEA5767_I2CScheduler(TEA5767_SchedDevice *device, byte deviceMax, TEA5767_SchedEntry *queue, byte queueMax);
+
+    byte addDevice(byte priority, unsigned long budget = 0);  // device id, TEA5767_ERROR if full
+    bool submit(byte dev, TEA5767_SchedJob job, void *arg, unsigned int cost = TEA5767_SCHED_COST);  // false if the queue is full
+    byte run(byte dev, TEA5767_SchedJob job, void *arg);  // now, after the queued jobs of higher priority
+    byte service(unsigned long window = 0xFFFFFFFF);     // queued jobs fit in window us, returns jobs done
+    void wait(unsigned long ms);                          // delay() servicing the queue
+
+    byte pending();
+    const TEA5767_SchedDevice &stat(byte dev) { return device[dev]; }
+    float utilisation();            // % of time the bus is busy
+    float utilisation(byte dev);    // % of time the bus is busy with dev
+    unsigned long avgQueueDelay(byte dev);  // us
+    void printStats();
+    void resetStats();
+};
+
+// Scheduler with its own arrays
+template <byte Devices = TEA5767_SCHED_DEVICES, byte Queue = TEA5767_SCHED_QUEUE>
+class TEA5767_I2CSchedulerBuffer : public TEA5767_I2CScheduler {
+   private:
+    TEA5767_SchedDevice devices[Devices];
+    TEA5767_SchedEntry entries[Queue];
+
+   public:
+    TEA5767_I2CSchedulerBuffer() : TEA5767_I2CScheduler(devices, Devices, entries, Queue) {}
+};
+
+// The tuner on the scheduler, Bus policy of TEA5767_Driver
+template <class Bus = TEA5767_WireBus>
+class TEA5767_SchedBus {
+   private:
+    TEA5767_I2CScheduler *sched;
+    byte dev;
+    Bus bus;
+
+    typedef struct Transfer {
+        Bus *bus;
+        byte *data;
+        byte len;
+    } Transfer;
+
+    static byte doWrite(void *arg) {
+        Transfer *t = (Transfer *)arg;
+        return t->bus->write(t->data, t->len);
+    }
+    static byte doRead(void *arg) {
+        Transfer *t = (Transfer *)arg;
+        return t->bus->read(t->data, t->len);
+    }
+
+   public:
+    TEA5767_SchedBus(TEA5767_I2CScheduler &sched, byte dev, const Bus &bus = Bus()) : sched(&sched), dev(dev), bus(bus) {}
+
+    byte write(const byte *data, byte len) {
+        Transfer t = {&bus, (byte *)data, len};
+        return sched->run(dev, doWrite, &t);
+    }
+    byte read(byte *data, byte len) {
+        Transfer t = {&bus, data, len};
+        return sched->run(dev, doRead, &t);
+    }
+};
+
+// The tuner's waits service the other devices, Clock policy of TEA5767_Driver
+class TEA5767_SchedClock {
+   private:
+    TEA5767_I2CScheduler *sched;
+
+   public:
+    TEA5767_SchedClock(TEA5767_I2CScheduler &sched) : sched(&sched) {}
+    unsigned long millis() { return ::millis(); }
+    void delay(unsigned long ms) { sched->wait(ms); }
+};
+
+#endif  // TEA5767_I2CSCHEDULER_H_
@@ -0,0 +1,358 @@
+/*
+	Project  : LaLiMat project (https://www.youtube.com/playlist?list=PLJBKmE2nNweRXOebZjydkMEiq2pHtBMOS in Chinese)
+ 	file     : TEA5767_Task.h
+	Author   : ykchau
+ 	youtube  : youtube.com/ykchau888
+  	Licenese : GPL-3.0
+   	Please let me know if you use it commercial project.
+*/
+
+/*
+    Drive TEA5767 from multiple tasks (ESP32/FreeRTOS, Linux)
+    - other tasks post TEA5767_Command to a lock-free queue
+    - one radio task owns the TEA5767 and calls process()
+    - status is published back by a seqlock, readers never block the radio task
+
+    e.g.
+        TEA5767 radio;
+        TEA5767_Task<TEA5767_SPSCQueue<16>> radioTask(radio);
+
+        // UI task
+        TEA5767_Command cmd = {TEA5767_CMD_SET_STATION, 98.1, 0, 0};
+        radioTask.post(cmd);
+
+        // radio task
+        while (1) { radioTask.process(); delay(10); }
+
+        // any task
+        TEA5767_Snapshot snap;
+        radioTask.snapshot(&snap);
+
+    Needs <atomic>, so it is not for AVR
+    Stress test with std::thread under ThreadSanitizer : make -C extras task_stress && extras/build/task_stress
+*/
+
+#ifndef TEA5767_TASK_H_
+#define TEA5767_TASK_H_
+
+#include <atomic>
+#include <string.h>
+
+#include "TEA5767.h"
+
+// Command
+#define TEA5767_CMD_NONE                0
+#define TEA5767_CMD_SET_STATION         1   // freq
+#define TEA5767_CMD_SEARCH              2   // arg1 = dir, arg2 = ssl
+#define TEA5767_CMD_SCAN                3   // arg1 = ssl
+#define TEA5767_CMD_NEXT_PRESET         4
+#define TEA5767_CMD_PREV_PRESET         5
+#define TEA5767_CMD_DELETE_PRESET       6
+#define TEA5767_CMD_TOGGLE_MUTE         7   // arg1 = channel
+#define TEA5767_CMD_TOGGLE_SOFT_MUTE    8
+#define TEA5767_CMD_TOGGLE_HCC          9
+#define TEA5767_CMD_TOGGLE_SNC          10
+#define TEA5767_CMD_TOGGLE_DTC          11
+#define TEA5767_CMD_TOGGLE_MODE         12
+#define TEA5767_CMD_PAUSE               13
+#define TEA5767_CMD_RESUME              14
+#define TEA5767_CMD_READ_STATUS         15
+#define TEA5767_CMD_RESCAN              16  // arg1 = ssl
+
+typedef struct TEA5767_Command {
+    byte op;
+    float freq;
+    byte arg1;
+    byte arg2;
+} TEA5767_Command;
+
+// Status published by the radio task
+typedef struct TEA5767_Snapshot {
+    TEA5767_Status status;
+    int xtalPPM;  // status.currentFreq(xtalPPM)
+    float searchingFreq;
+    byte searchProcessStatus;
+    byte readResult;  // last read_status()
+    int presetCount;
+    int curPreset;
+    float curPresetFreq;
+    unsigned long seq;  // number of publish
+} TEA5767_Snapshot;
+
+/*
+    Single producer / single consumer ring buffer
+    Size must be power of 2, one slot is kept empty
+*/
+template <unsigned int Size>
+class TEA5767_SPSCQueue {
+    static_assert(Size >= 2 && (Size & (Size - 1)) == 0, "TEA5767_SPSCQueue : Size must be power of 2");
+
+   private:
+    TEA5767_Command buf[Size];
+    std::atomic<unsigned int> head{0};  // written by consumer
+    std::atomic<unsigned int> tail{0};  // written by producer
+
+   public:
+    bool push(const TEA5767_Command &cmd) {
+        unsigned int t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) >= Size - 1) {
+            return false;  // full
+        }
+        buf[t & (Size - 1)] = cmd;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(TEA5767_Command *cmd) {
+        unsigned int h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) {
+            return false;  // empty
+        }
+        *cmd = buf[h & (Size - 1)];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+/*
+    Multi producer / single consumer ring buffer
+    bounded queue with a sequence number per cell (D. Vyukov), Size must be power of 2
+*/
+template <unsigned int Size>
+class TEA5767_MPSCQueue {
+    static_assert(Size >= 2 && (Size & (Size - 1)) == 0, "TEA5767_MPSCQueue : Size must be power of 2");
+
+   private:
+    struct Cell {
+        std::atomic<unsigned int> seq;
+        TEA5767_Command cmd;
+    };
+    Cell buf[Size];
+    std::atomic<unsigned int> tail{0};  // shared by producers
+    unsigned int head = 0;              // consumer only
+
+   public:
+    TEA5767_MPSCQueue() {
+        for (unsigned int i = 0; i < Size; i++) {
+            buf[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool push(const TEA5767_Command &cmd) {
+        unsigned int t = tail.load(std::memory_order_relaxed);
+        while (1) {
+            Cell &c = buf[t & (Size - 1)];
+            int diff = (int)(c.seq.load(std::memory_order_acquire) - t);
+            if (diff == 0) {
+                // cell free, claim it
+                if (tail.compare_exchange_weak(t, t + 1, std::memory_order_relaxed)) {
+                    c.cmd = cmd;
+                    c.seq.store(t + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // full
+            } else {
+                t = tail.load(std::memory_order_relaxed);  // claimed by other producer
+            }
+        }
+    }
+
+    bool pop(TEA5767_Command *cmd) {
+        Cell &c = buf[head & (Size - 1)];
+        if (c.seq.load(std::memory_order_acquire) != head + 1) {
+            return false;  // empty, or producer still writing
+        }
+        *cmd = c.cmd;
+        c.seq.store(head + Size, std::memory_order_release);
+        head++;
+        return true;
+    }
+};
+
+/*
+    Seqlock of TEA5767_Snapshot
+    single writer, the data is copied word by word in atomics so readers never see a torn value
+    release/acquire on the data words instead of fences, so it is also clean under ThreadSanitizer
+*/
+class TEA5767_SnapshotLock {
+   private:
+    static const unsigned int WORDS = (sizeof(TEA5767_Snapshot) + 3) / 4;
+
+    std::atomic<unsigned long> seq{0};  // odd while writing
+    std::atomic<uint32_t> data[WORDS];
+
+   public:
+    TEA5767_SnapshotLock() {
+        for (unsigned int i = 0; i < WORDS; i++) {
+            data[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void write(const TEA5767_Snapshot &snap) {
+        uint32_t w[WORDS] = {0};
+        memcpy(w, &snap, sizeof(TEA5767_Snapshot));
+
+        unsigned long s = seq.load(std::memory_order_relaxed);
+        seq.store(s + 1, std::memory_order_relaxed);
+        for (unsigned int i = 0; i < WORDS; i++) {
+            data[i].store(w[i], std::memory_order_release);  // a reader seeing this word also sees seq odd
+        }
+        seq.store(s + 2, std::memory_order_release);
+    }
+
+    // single attempt, false if the writer is updating
+    bool tryRead(TEA5767_Snapshot *snap) {
+        uint32_t w[WORDS];
+
+        unsigned long s1 = seq.load(std::memory_order_acquire);
+        if (s1 & 1) {
+            return false;
+        }
+        for (unsigned int i = 0; i < WORDS; i++) {
+            w[i] = data[i].load(std::memory_order_acquire);
+        }
+        if (seq.load(std::memory_order_relaxed) != s1) {
+            return false;
+        }
+
+        memcpy(snap, w, sizeof(TEA5767_Snapshot));
+        return true;
+    }
+
+    void read(TEA5767_Snapshot *snap) {
+        while (!tryRead(snap)) {
+        }
+    }
+};
+
+/*
+    Radio task, the only one touching the TEA5767 object
+    Queue : TEA5767_SPSCQueue (one commanding task) or TEA5767_MPSCQueue (many)
+    Radio : TEA5767 or any TEA5767_Driver<Bus, Clock>
+*/
+template <class Queue, class Radio = TEA5767>
+class TEA5767_Task {
+   private:
+    Radio &radio;
+    Queue queue;
+    TEA5767_SnapshotLock lock;
+    byte readResult = TEA5767_READ_OK;
+    unsigned long publishCount = 0;
+
+    void execute(const TEA5767_Command &cmd) {
+        switch (cmd.op) {
+            case TEA5767_CMD_SET_STATION:
+                radio.setStation(cmd.freq);
+                break;
+            case TEA5767_CMD_SEARCH:
+                radio.searchStation(cmd.arg1, cmd.arg2);
+                break;
+            case TEA5767_CMD_SCAN:
+                radio.scanStation(cmd.arg1);
+                break;
+            case TEA5767_CMD_NEXT_PRESET:
+                radio.nextPreset();
+                break;
+            case TEA5767_CMD_PREV_PRESET:
+                radio.prevPreset();
+                break;
+            case TEA5767_CMD_DELETE_PRESET:
+                radio.deleteCurFreqPreset();
+                break;
+            case TEA5767_CMD_TOGGLE_MUTE:
+                radio.toggleMute(cmd.arg1);
+                break;
+            case TEA5767_CMD_TOGGLE_SOFT_MUTE:
+                radio.toggleSoftMute();
+                break;
+            case TEA5767_CMD_TOGGLE_HCC:
+                radio.toggleHighCutControl();
+                break;
+            case TEA5767_CMD_TOGGLE_SNC:
+                radio.toggleStereoNoiseCancelling();
+                break;
+            case TEA5767_CMD_TOGGLE_DTC:
+                radio.toggleDeemphasisTimeConstant();
+                break;
+            case TEA5767_CMD_TOGGLE_MODE:
+                radio.toggleMode();
+                break;
+            case TEA5767_CMD_PAUSE:
+                radio.pause();
+                break;
+            case TEA5767_CMD_RESUME:
+                radio.resume();
+                break;
+            case TEA5767_CMD_RESCAN:
+                radio.rescanStation(cmd.arg1);
+                break;
+            case TEA5767_CMD_READ_STATUS:
+                readResult = radio.read_status();
+                break;
+        }
+    }
+
+    void publish() {
+        TEA5767_Snapshot snap;
+        snap.status = radio.status;
+        snap.xtalPPM = radio.xtalPPM;
+        snap.searchingFreq = radio.searchingFreq;
+        snap.searchProcessStatus = radio.searchProcessStatus;
+        snap.readResult = readResult;
+        snap.presetCount = radio.presetCount();
+        snap.curPreset = radio.currentPreset();
+        snap.curPresetFreq = radio.presetAt(snap.curPreset);
+        snap.seq = ++publishCount;
+        lock.write(snap);
+    }
+
+   public:
+    // before the radio task starts, the first snapshot is a real read
+    TEA5767_Task(Radio &radio) : radio(radio) {
+        readResult = radio.read_status();
+        publish();
+    }
+
+    // any task (one task for TEA5767_SPSCQueue), false if the queue is full
+    bool post(const TEA5767_Command &cmd) {
+        return queue.push(cmd);
+    }
+
+    // radio task only
+    // run all pending commands, continue a pending search by one step or a rescan by one batch (paced by rescanInterval), then publish the status
+    // return the number of commands executed
+    byte process() {
+        TEA5767_Command cmd;
+        byte n = 0;
+
+        while (queue.pop(&cmd)) {
+            execute(cmd);
+            n++;
+        }
+
+        if (radio.searchProcessStatus == TEA5767_SEARCH_PENDING) {
+            radio.searchProcess();
+            n++;
+        } else if (radio.rescanStatus == TEA5767_SEARCH_PENDING) {
+            radio.rescanProcess(TEA5767_RESCAN_BATCH);
+            n++;
+        }
+
+        if (n > 0) {
+            publish();
+        }
+        return n;
+    }
+
+    // any task, never blocked by the radio task
+    bool trySnapshot(TEA5767_Snapshot *snap) {
+        return lock.tryRead(snap);
+    }
+
+    void snapshot(TEA5767_Snapshot *snap) {
+        lock.read(snap);
+    }
+};
+
+#endif  // TEA5767_TASK_H_
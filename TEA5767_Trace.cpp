@@ -0,0 +1,194 @@
+/*
+	Project  : LaLiMat project (https://www.youtube.com/playlist?list=PLJBKmE2nNweRXOebZjydkMEiq2pHtBMOS in Chinese)
+ 	file     : TEA5767_Trace.cpp
+	Author   : ykchau
+ 	youtube  : youtube.com/ykchau888
+  	Licenese : GPL-3.0
+   	Please let me know if you use it commercial project.
+*/
+#include "TEA5767_Trace.h"
+
+#ifndef ARDUINO
+#include <stdio.h>
+#endif
+
+/**************************
+    Recorder
+**************************/
+void TEA5767_Recorder::record(byte type, byte result, const byte *data, unsigned long time) {
+    TEA5767_Trace *t = &buf[head];
+
+    t->time = time;
+    t->type = type;
+    t->result = result;
+    for (byte i = 0; i < 5; i++) {
+        t->data[i] = data[i];
+    }
+
+    if (out != NULL) {
+        byte entry[TEA5767_TRACE_BYTES];
+        encode(*t, entry);
+        out->write(entry, TEA5767_TRACE_BYTES);
+    }
+
+    head = (head + 1) % capacity;
+    if (count < capacity) {
+        count++;
+    } else {
+        dropped++;
+    }
+}
+
+void TEA5767_Recorder::clear() {
+    head = 0;
+    count = 0;
+    dropped = 0;
+}
+
+const TEA5767_Trace &TEA5767_Recorder::at(unsigned int i) {
+    return buf[(head + capacity - count + i) % capacity];
+}
+
+void TEA5767_Recorder::encode(const TEA5767_Trace &t, byte *out) {
+    for (byte b = 0; b < 4; b++) {
+        out[b] = (t.time >> (8 * b)) & 0xFF;
+    }
+    out[4] = t.type;
+    out[5] = t.result;
+    for (byte b = 0; b < 5; b++) {
+        out[6 + b] = t.data[b];
+    }
+}
+
+unsigned int TEA5767_Recorder::serialize(byte *out, unsigned int len) {
+    unsigned int n = 0;
+
+    for (unsigned int i = 0; i < count && n + TEA5767_TRACE_BYTES <= len; i++) {
+        encode(at(i), out + n);
+        n += TEA5767_TRACE_BYTES;
+    }
+
+    return n;
+}
+
+void TEA5767_Recorder::dump() {
+    byte entry[TEA5767_TRACE_BYTES];
+
+    for (unsigned int i = 0; i < count; i++) {
+        encode(at(i), entry);
+        Serial.write(entry, TEA5767_TRACE_BYTES);
+    }
+}
+
+void TEA5767_Recorder::stream(Print *o) {
+    out = o;
+}
+
+/**************************
+    Replay
+**************************/
+TEA5767_Replay::~TEA5767_Replay() {
+    free(loaded);
+}
+
+void TEA5767_Replay::attach(const TEA5767_Trace *t, unsigned int n) {
+    trace = t;
+    count = n;
+    pos = 0;
+    mismatch = 0;
+    overrun = 0;
+    clock = (n > 0) ? t[0].time : 0;
+}
+
+bool TEA5767_Replay::load(const byte *buf, unsigned int len) {
+    unsigned int n = len / TEA5767_TRACE_BYTES;
+
+    free(loaded);
+    loaded = (TEA5767_Trace *)calloc(n > 0 ? n : 1, sizeof(TEA5767_Trace));
+    if (loaded == NULL) {
+        attach(NULL, 0);
+        return false;
+    }
+
+    for (unsigned int i = 0; i < n; i++) {
+        const byte *in = buf + i * TEA5767_TRACE_BYTES;
+        TEA5767_Trace *t = &loaded[i];
+
+        t->time = 0;
+        for (byte b = 0; b < 4; b++) {
+            t->time |= (unsigned long)in[b] << (8 * b);
+        }
+        t->type = in[4];
+        t->result = in[5];
+        for (byte b = 0; b < 5; b++) {
+            t->data[b] = in[6 + b];
+        }
+    }
+
+    attach(loaded, n);
+    return true;
+}
+
+#ifndef ARDUINO
+bool TEA5767_Replay::loadFile(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        return false;
+    }
+
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    byte *buf = (byte *)malloc(len > 0 ? len : 1);
+    bool ok = buf != NULL && fread(buf, 1, len, f) == (size_t)len && load(buf, len);
+
+    free(buf);
+    fclose(f);
+    return ok;
+}
+#endif
+
+// Next entry of the trace, the clock follows the recorded time
+const TEA5767_Trace *TEA5767_Replay::next(byte type) {
+    if (pos >= count) {
+        overrun++;
+        return NULL;
+    }
+
+    const TEA5767_Trace *t = &trace[pos++];
+    if (t->type != type) {
+        mismatch++;
+    }
+    if ((long)(t->time - clock) > 0) {  // wrap-safe, never go back
+        clock = t->time;
+    }
+    return t;
+}
+
+byte TEA5767_Replay::write(const byte *data) {
+    const TEA5767_Trace *t = next(TEA5767_TRACE_WRITE);
+    if (t == NULL) {
+        return 4;  // endTransmission() other error
+    }
+
+    for (byte i = 0; i < 5; i++) {
+        if (t->data[i] != data[i]) {
+            mismatch++;
+            break;
+        }
+    }
+    return t->result;
+}
+
+byte TEA5767_Replay::read(byte *data) {
+    const TEA5767_Trace *t = next(TEA5767_TRACE_READ);
+    if (t == NULL) {
+        return 0;  // nothing received
+    }
+
+    for (byte i = 0; i < 5; i++) {
+        data[i] = t->data[i];
+    }
+    return t->result;
+}
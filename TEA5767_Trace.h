@@ -0,0 +1,174 @@
+/*
+	Project  : LaLiMat project (https://www.youtube.com/playlist?list=PLJBKmE2nNweRXOebZjydkMEiq2pHtBMOS in Chinese)
+ 	file     : TEA5767_Trace.h
+	Author   : ykchau
+ 	youtube  : youtube.com/ykchau888
+  	Licenese : GPL-3.0
+   	Please let me know if you use it commercial project.
+*/
+
+/*
+    I2C transaction recorder and replay engine, as Bus / Clock policies of TEA5767_Driver
+
+    Field unit :
+        TEA5767_RecorderBuffer<> recorder;  // the last TEA5767_TRACE_SIZE transactions
+        TEA5767_Driver<TEA5767_RecordBus<>> radio((TEA5767_RecordBus<>(recorder)));
+        ...
+        recorder.dump();  // binary trace to Serial
+
+    Field unit, replayable trace of any length :
+        Serial.begin(115200);
+        recorder.stream(&Serial);  // or an SD File, every transaction as it happens
+        radio.init();              // the streamed trace starts here, as the constructor of the replay driver
+
+    Bench / Linux :
+        TEA5767_Replay replay;
+        replay.load(buf, len);  // or replay.loadFile("trace.bin"), a trace from init() on, streamed or dropped = 0
+        TEA5767_Driver<TEA5767_ReplayBus, TEA5767_ReplayClock> radio((TEA5767_ReplayBus(replay)), TEA5767_ReplayClock(replay));
+        radio.scanStation(TEA5767_SSL_HIGH);  // same decision path, same timing
+        replay.mismatch;  // writes differ from the trace
+*/
+
+#ifndef TEA5767_TRACE_H_
+#define TEA5767_TRACE_H_
+
+#include "TEA5767.h"
+
+#define TEA5767_TRACE_SIZE      64      // default entries of TEA5767_RecorderBuffer, the last transactions for a field report
+#define TEA5767_TRACE_SCAN      1300    // entries of init() + scanStation(), for a replay of a scan
+
+#define TEA5767_TRACE_WRITE     0
+#define TEA5767_TRACE_READ      1
+
+#define TEA5767_TRACE_BYTES     11      // size of an entry in the binary trace
+
+// One I2C transaction
+typedef struct TEA5767_Trace {
+    unsigned long time;  // millis() of the transaction
+    byte type;           // TEA5767_TRACE_WRITE/READ
+    byte result;         // endTransmission() for write, number of bytes received for read
+    byte data[5];        // writeData or rawData
+} TEA5767_Trace;
+
+// Ring buffer of the last capacity transactions, the oldest one is overwritten
+// the storage comes from TEA5767_RecorderBuffer, TEA5767_Trace.cpp is compiled once for any ring size
+// stream() also writes each transaction out when it is recorded, a trace the ring can't hold
+class TEA5767_Recorder {
+   private:
+    TEA5767_Trace *buf;
+    unsigned int capacity;
+    unsigned int head = 0;   // next entry to write
+    unsigned int count = 0;  // entries in buf
+    Print *out = NULL;       // stream()
+
+    void encode(const TEA5767_Trace &t, byte *out);
+
+   public:
+    unsigned long dropped = 0;  // overwritten entries, a replay of the ring needs dropped = 0
+
+    TEA5767_Recorder(TEA5767_Trace *buf, unsigned int capacity) : buf(buf), capacity(capacity) {}
+
+    void record(byte type, byte result, const byte *data, unsigned long time);
+    void clear();
+    unsigned int size() { return count; }
+    const TEA5767_Trace &at(unsigned int i);  // 0 is the oldest
+
+    // Binary trace, TEA5767_TRACE_BYTES per entry, little endian
+    // time[4] type[1] result[1] data[5]
+    unsigned int serialize(byte *out, unsigned int len);  // return bytes written
+    void dump();                                          // to Serial
+    void stream(Print *out);                              // each new entry to out as well, NULL to stop
+};
+
+// Recorder with its own buffer of Size entries
+// replay runs from init(), a ring replay needs room for every transaction from the constructor of the driver :
+// init() 1, setStation() 2, scanStation() ~1240 (TEA5767_TRACE_SCAN), each TEA5767_Trace is 11 (AVR) ~ 16 bytes of RAM
+// too much for an AVR, stream() the trace instead
+template <unsigned int Size = TEA5767_TRACE_SIZE>
+class TEA5767_RecorderBuffer : public TEA5767_Recorder {
+   private:
+    TEA5767_Trace storage[Size];
+
+   public:
+    TEA5767_RecorderBuffer() : TEA5767_Recorder(storage, Size) {}
+};
+
+// Feed a trace back to the driver instead of the bus
+class TEA5767_Replay {
+   private:
+    const TEA5767_Trace *trace = NULL;
+    unsigned int count = 0;
+    unsigned long clock = 0;
+    TEA5767_Trace *loaded = NULL;  // owned copy of load()
+
+    const TEA5767_Trace *next(byte type);
+
+   public:
+    unsigned int pos = 0;          // next entry
+    unsigned int mismatch = 0;     // write image or transaction type not as recorded
+    unsigned int overrun = 0;      // transaction after the end of the trace
+
+    ~TEA5767_Replay();
+
+    void attach(const TEA5767_Trace *trace, unsigned int count);
+    bool load(const byte *buf, unsigned int len);  // binary trace of TEA5767_Recorder::serialize()
+#ifndef ARDUINO
+    bool loadFile(const char *path);
+#endif
+    bool finished() { return pos >= count; }
+
+    // Driver side
+    unsigned long millis() { return clock; }
+    void delay(unsigned long ms) { clock += ms; }
+    byte write(const byte *data);  // return endTransmission() result of the trace
+    byte read(byte *data);         // return number of bytes received of the trace
+};
+
+// Bus recording every transaction of Bus
+template <class Bus = TEA5767_WireBus, class Clock = TEA5767_ArduinoClock>
+class TEA5767_RecordBus {
+   private:
+    TEA5767_Recorder *recorder;
+    Bus bus;
+    Clock clock;
+
+   public:
+    TEA5767_RecordBus(TEA5767_Recorder &recorder, const Bus &bus = Bus(), const Clock &clock = Clock())
+        : recorder(&recorder), bus(bus), clock(clock) {}
+
+    byte write(const byte *data, byte len) {
+        unsigned long time = clock.millis();
+        byte result = bus.write(data, len);
+        recorder->record(TEA5767_TRACE_WRITE, result, data, time);
+        return result;
+    }
+
+    byte read(byte *data, byte len) {
+        byte rec = bus.read(data, len);
+        recorder->record(TEA5767_TRACE_READ, rec, data, clock.millis());
+        return rec;
+    }
+};
+
+// Bus and Clock fed by a trace
+class TEA5767_ReplayBus {
+   private:
+    TEA5767_Replay *replay;
+
+   public:
+    TEA5767_ReplayBus(TEA5767_Replay &replay) : replay(&replay) {}
+    byte write(const byte *data, byte) { return replay->write(data); }
+    byte read(byte *data, byte) { return replay->read(data); }
+};
+
+class TEA5767_ReplayClock {
+   private:
+    TEA5767_Replay *replay;
+
+   public:
+    TEA5767_ReplayClock(TEA5767_Replay &replay) : replay(&replay) {}
+    unsigned long millis() { return replay->millis(); }
+    void delay(unsigned long ms) { replay->delay(ms); }
+};
+
+#endif  // TEA5767_TRACE_H_
@@ -0,0 +1,48 @@
+/*
+	Project  : LaLiMat project (https://www.youtube.com/playlist?list=PLJBKmE2nNweRXOebZjydkMEiq2pHtBMOS in Chinese)
+ 	file     : calibrate.cpp
+	Author   : ykchau
+ 	youtube  : youtube.com/ykchau888
+  	Licenese : GPL-3.0
+   	Please let me know if you use it commercial project.
+*/
+
+/*
+    calibrate() on TEA5767_SimBus with a detuned crystal
+    reports the fitted xtalPPM and the stations used for each crystal error
+    usage : calibrate [seed]
+    exit 1 if a fit is more than CAL_TOLERANCE ppm off, or used no station
+*/
+#include "TEA5767_Soak.h"
+
+#define CAL_TOLERANCE 60  // ppm, PLL step and IF counter +/-1 noise
+
+// strong stations of TEA5767_SimBus
+static const float freqs[] = {88.1, 91.5, 98.0, 104.5};
+
+int main(int argc, char **argv) {
+    unsigned long seed = (argc > 1) ? strtoul(argv[1], NULL, 10) : 1;
+    static const int errors[] = {0, 150, -500, 1000};
+    int failures = 0;
+
+    Serial.enabled = false;  // driver log
+
+    printf("%-8s %8s %6s\n", "xtal", "fitted", "used");
+    for (byte e = 0; e < sizeof(errors) / sizeof(errors[0]); e++) {
+        TEA5767_SoakContext ctx;
+        ctx.seed = seed;
+        TEA5767_SimBus sim(ctx);
+        sim.ppm = errors[e];
+
+        TEA5767_Driver<TEA5767_SimBus, TEA5767_SimClock> radio(sim, TEA5767_SimClock(ctx));
+        byte used = radio.calibrate(freqs, sizeof(freqs) / sizeof(freqs[0]));
+
+        printf("%-8d %8d %6d\n", errors[e], radio.xtalPPM, used);
+        if (used == 0 || abs(radio.xtalPPM - errors[e]) > CAL_TOLERANCE) {
+            failures++;
+        }
+    }
+
+    printf("%s\n", failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,42 @@
+/*
+	Project  : LaLiMat project (https://www.youtube.com/playlist?list=PLJBKmE2nNweRXOebZjydkMEiq2pHtBMOS in Chinese)
+ 	file     : Arduino.cpp
+	Author   : ykchau
+ 	youtube  : youtube.com/ykchau888
+  	Licenese : GPL-3.0
+   	Please let me know if you use it commercial project.
+*/
+#include "Arduino.h"
+#include "Wire.h"
+
+#include <atomic>
+
+HardwareSerial Serial;
+TwoWire Wire;
+
+static std::atomic<unsigned long long> hostTime{0};  // us, read by every thread
+
+unsigned long millis() { return hostTime / 1000; }
+unsigned long micros() { return hostTime; }
+void delay(unsigned long ms) { hostTime += (unsigned long long)ms * 1000; }
+void delayMicroseconds(unsigned int us) { hostTime += us; }
+
+static std::string toBase(unsigned long v, int base) {
+    char buf[8 * sizeof(long) + 1];
+    char *p = buf + sizeof(buf) - 1;
+    *p = 0;
+    do {
+        *--p = "0123456789ABCDEF"[v % base];
+        v /= base;
+    } while (v > 0);
+    return p;
+}
+
+String::String(long v, int base) : s(v < 0 && base == DEC ? "-" + toBase(-(unsigned long)v, base) : toBase(v, base)) {}
+String::String(unsigned long v, int base) : s(toBase(v, base)) {}
+
+String::String(double v, int decimals) {
+    char buf[40];
+    snprintf(buf, sizeof(buf), "%.*f", decimals, v);
+    s = buf;
+}
@@ -0,0 +1,88 @@
+/*
+	Project  : LaLiMat project (https://www.youtube.com/playlist?list=PLJBKmE2nNweRXOebZjydkMEiq2pHtBMOS in Chinese)
+ 	file     : Arduino.h
+	Author   : ykchau
+ 	youtube  : youtube.com/ykchau888
+  	Licenese : GPL-3.0
+   	Please let me know if you use it commercial project.
+*/
+
+/*
+    Host (Linux) stand-in of the Arduino core, only what the library uses
+    - virtual time : millis() / micros() move only by delay() / delayMicroseconds()
+    - Serial prints to stdout, Serial.enabled = false to keep it quiet
+*/
+
+#ifndef ARDUINO_HOST_H_
+#define ARDUINO_HOST_H_
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+using std::max;
+using std::min;
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+#define DEC 10
+#define HEX 16
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+class String {
+   private:
+    std::string s;
+
+   public:
+    String(const char *str = "") : s(str) {}
+    String(const std::string &str) : s(str) {}
+    String(char c) : s(1, c) {}
+    String(int v, int base = DEC) : String((long)v, base) {}
+    String(unsigned int v, int base = DEC) : String((unsigned long)v, base) {}
+    String(long v, int base = DEC);
+    String(unsigned long v, int base = DEC);
+    String(double v, int decimals = 2);  // 2 decimals as the Arduino core
+
+    template <class T>
+    String operator+(const T &v) const { return String(s + String(v).s); }
+    String operator+(const char *v) const { return String(s + v); }
+
+    const char *c_str() const { return s.c_str(); }
+    unsigned int length() const { return s.length(); }
+};
+
+// write() of Arduino's Print, the sink of TEA5767_Recorder::stream()
+class Print {
+   public:
+    virtual ~Print() {}
+    virtual size_t write(const byte *data, size_t len) = 0;
+};
+
+class HardwareSerial : public Print {
+   public:
+    bool enabled = true;
+
+    void begin(unsigned long) {}
+    void print(const String &str) { if (enabled) fputs(str.c_str(), stdout); }
+    void println(const String &str) { if (enabled) puts(str.c_str()); }
+    template <class T>
+    void print(T v, int base) { print(String(v, base)); }
+    template <class T>
+    void println(T v, int base) { println(String(v, base)); }
+    size_t write(const byte *data, size_t len) override { return enabled ? fwrite(data, 1, len, stdout) : len; }
+};
+
+extern HardwareSerial Serial;
+
+#endif  // ARDUINO_HOST_H_
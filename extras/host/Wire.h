@@ -0,0 +1,60 @@
+/*
+	Project  : LaLiMat project (https://www.youtube.com/playlist?list=PLJBKmE2nNweRXOebZjydkMEiq2pHtBMOS in Chinese)
+ 	file     : Wire.h
+	Author   : ykchau
+ 	youtube  : youtube.com/ykchau888
+  	Licenese : GPL-3.0
+   	Please let me know if you use it commercial project.
+*/
+
+/*
+    Host (Linux) stand-in of the Arduino Wire library
+    the device on the bus is a pair of callbacks, no device = NACK
+*/
+
+#ifndef WIRE_HOST_H_
+#define WIRE_HOST_H_
+
+#include "Arduino.h"
+
+#define WIRE_BUFFER_SIZE 32
+
+class TwoWire {
+   private:
+    byte address = 0;
+    byte txBuf[WIRE_BUFFER_SIZE];
+    byte txLen = 0;
+    byte rxBuf[WIRE_BUFFER_SIZE];
+    byte rxLen = 0;
+    byte rxPos = 0;
+
+   public:
+    byte (*onWrite)(byte address, const byte *data, byte len) = NULL;  // return endTransmission() result
+    byte (*onRead)(byte address, byte *data, byte len) = NULL;         // return bytes sent
+
+    void begin() {}
+    void beginTransmission(byte addr) {
+        address = addr;
+        txLen = 0;
+    }
+    size_t write(byte data) {
+        if (txLen >= WIRE_BUFFER_SIZE) {
+            return 0;
+        }
+        txBuf[txLen++] = data;
+        return 1;
+    }
+    byte endTransmission() { return onWrite ? onWrite(address, txBuf, txLen) : 2; }
+    byte requestFrom(byte addr, byte len) {
+        len = min(len, (byte)WIRE_BUFFER_SIZE);
+        rxLen = onRead ? min(onRead(addr, rxBuf, len), len) : 0;
+        rxPos = 0;
+        return rxLen;
+    }
+    int available() { return rxLen - rxPos; }
+    int read() { return (rxPos < rxLen) ? rxBuf[rxPos++] : -1; }
+};
+
+extern TwoWire Wire;
+
+#endif  // WIRE_HOST_H_
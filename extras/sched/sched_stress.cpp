@@ -0,0 +1,114 @@
+/*
+	Project  : LaLiMat project (https://www.youtube.com/playlist?list=PLJBKmE2nNweRXOebZjydkMEiq2pHtBMOS in Chinese)
+ 	file     : sched_stress.cpp
+	Author   : ykchau
+ 	youtube  : youtube.com/ykchau888
+  	Licenese : GPL-3.0
+   	Please let me know if you use it commercial project.
+*/
+
+/*
+    A display task submitting to TEA5767_I2CScheduler while the tuner's task tunes, with std::thread
+    once without budgets, once with the display limited to DISPLAY_BUDGET us per TEA5767_SCHED_PERIOD
+    built with ThreadSanitizer by the Makefile, a data race aborts with its report
+    usage : sched_stress [tunes]
+    exit 1 on a lost job or a tune not locked, or a display budget not counted / not kept
+*/
+#include <stdio.h>
+
+#include <atomic>
+#include <thread>
+
+#include "TEA5767_I2CScheduler.h"
+
+#define FRAMES_PER_TUNE 8
+#define DISPLAY_BUDGET  5000  // us, 5 frames per period
+
+static std::atomic<unsigned long> flushed{0};
+
+// one display transaction, 1ms on the bus
+static byte flush(void *) {
+    flushed++;
+    delayMicroseconds(1000);
+    return 0;
+}
+
+// A TEA5767 on the host Wire, ready and locked on the channel written
+static byte reg[5];
+static byte tunerWrite(byte, const byte *data, byte len) {
+    memcpy(reg, data, min(len, (byte)5));
+    return 0;
+}
+static byte tunerRead(byte, byte *data, byte len) {
+    byte raw[5] = {(byte)(0x80 | (reg[0] & 0x3F)), reg[1], TEA5767_IF_CENTER, 0xA0, 0};
+    memcpy(data, raw, min(len, (byte)5));
+    return len;
+}
+
+// failures of one run, budget 0 = no limit
+static unsigned long stress(unsigned long tunes, unsigned long budget) {
+    unsigned long failures = 0;
+    flushed.store(0);
+
+    TEA5767_I2CSchedulerBuffer<2, 4> sched;
+    byte display = sched.addDevice(0, budget);
+    byte tuner = sched.addDevice(1);
+    TEA5767_Driver<TEA5767_SchedBus<>, TEA5767_SchedClock> radio(TEA5767_SchedBus<>(sched, tuner), TEA5767_SchedClock(sched));
+
+    // display task
+    unsigned long frames = tunes * FRAMES_PER_TUNE;
+    std::atomic<bool> submitted{false};
+    std::thread displayTask([&] {
+        for (unsigned long n = 0; n < frames; n++) {
+            while (!sched.submit(display, flush, NULL, 1000)) {
+                std::this_thread::yield();
+            }
+        }
+        submitted.store(true);
+    });
+
+    // tuner's task, owns the bus
+    for (unsigned long n = 0; n < tunes; n++) {
+        float freq = 88 + n % 20;
+        radio.setStation(freq);
+        if (radio.status.PLL() == 0 || fabs(radio.currentFreq() - freq) > 0.05) {
+            failures++;
+        }
+        std::this_thread::yield();
+    }
+    // the rest of the frames, waiting for the budget to be refilled
+    while (!submitted.load() || sched.pending() > 0) {
+        sched.wait(1);
+        std::this_thread::yield();
+    }
+    displayTask.join();
+
+    if (flushed.load() != frames || sched.stat(display).jobs != frames) {
+        failures++;
+    }
+    // queued frames held back are counted, and the display stays within its share of the bus (+ one frame per period)
+    if (budget > 0 && (sched.stat(display).overBudget == 0 ||
+                       sched.utilisation(display) > (budget + 1000) * 100.0 / (TEA5767_SCHED_PERIOD * 1000UL))) {
+        failures++;
+    }
+
+    printf("budget %luus : tunes %lu, frames %lu/%lu, utilisation %.1f%% (display %.1f%%), display avg delay %luus max %luus "
+           "over budget %lu, tuner avg delay %luus\n",
+           budget, tunes, flushed.load(), frames, sched.utilisation(), sched.utilisation(display), sched.avgQueueDelay(display),
+           sched.stat(display).maxQueueDelay, sched.stat(display).overBudget, sched.avgQueueDelay(tuner));
+    return failures;
+}
+
+int main(int argc, char **argv) {
+    unsigned long tunes = (argc > 1) ? strtoul(argv[1], NULL, 10) : 200;
+
+    Serial.enabled = false;  // driver log
+    Wire.onWrite = tunerWrite;
+    Wire.onRead = tunerRead;
+
+    unsigned long failures = stress(tunes, 0);
+    failures += stress(tunes, DISPLAY_BUDGET);
+
+    printf("%s, %lu failures\n", failures ? "FAILED" : "OK", failures);
+    return failures ? 1 : 0;
+}
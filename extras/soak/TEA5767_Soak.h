@@ -0,0 +1,447 @@
+/*
+	Project  : LaLiMat project (https://www.youtube.com/playlist?list=PLJBKmE2nNweRXOebZjydkMEiq2pHtBMOS in Chinese)
+ 	file     : TEA5767_Soak.h
+	Author   : ykchau
+ 	youtube  : youtube.com/ykchau888
+  	Licenese : GPL-3.0
+   	Please let me know if you use it commercial project.
+*/
+
+/*
+    Fault-injection soak harness, Linux only
+    - TEA5767_SimBus     : a TEA5767 with some stations on the band
+    - TEA5767_FaultBus   : drop, delay, truncate, corrupt or zero the PLL of transfers at configurable rates
+    - TEA5767_SimClock   : virtual time, advanced by delay() and by every transfer
+    - TEA5767_Soak       : long randomized sequences of tune/seek/scan/preset/toggle operations,
+                           report latency percentiles, recovery time after a fault, hangs and preset index out of range
+
+    Build and run on Linux (host Arduino/Wire in extras/host, AddressSanitizer on) :
+        make -C extras check
+        extras/build/soak [ops] [seed] [fault rate]
+    see soak.cpp for the setup of the rates
+*/
+
+#ifndef TEA5767_SOAK_H_
+#define TEA5767_SOAK_H_
+
+#ifdef ARDUINO
+#error "TEA5767_Soak.h is for the Linux build"
+#endif
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "TEA5767.h"
+
+#define TEA5767_SOAK_TRANSFER_US    600         // 5 bytes at 100KHz
+#define TEA5767_SOAK_HANG_MS        600000UL    // virtual time of one operation before it is a hang
+#define TEA5767_SOAK_SPIN           1000000UL   // millis() calls without time passing before it is a hang
+#define TEA5767_SOAK_SEARCH_STEPS   250         // searchProcess() calls of one search
+
+// Operations
+#define TEA5767_SOAK_SET_STATION    0
+#define TEA5767_SOAK_SEARCH         1
+#define TEA5767_SOAK_SCAN           2
+#define TEA5767_SOAK_RESCAN         3
+#define TEA5767_SOAK_NEXT_PRESET    4
+#define TEA5767_SOAK_PREV_PRESET    5
+#define TEA5767_SOAK_DELETE_PRESET  6
+#define TEA5767_SOAK_TOGGLE         7
+#define TEA5767_SOAK_PAUSE_RESUME   8
+#define TEA5767_SOAK_READ_STATUS    9
+#define TEA5767_SOAK_OPS            10
+
+// Thrown by TEA5767_SimClock when an operation never ends
+typedef struct TEA5767_SoakHang {
+    int dummy;
+} TEA5767_SoakHang;
+
+// Fault rates, probability per transfer
+typedef struct TEA5767_FaultRate {
+    float drop = 0;       // NACK, nothing transferred
+    float delay = 0;      // clock stretching of 1 ~ delayMax ms
+    float truncate = 0;   // 1 ~ 4 bytes transferred
+    float corrupt = 0;    // one bit flipped
+    float zeroPLL = 0;    // read with PLL = 0
+    unsigned int delayMax = 30;
+} TEA5767_FaultRate;
+
+// Shared by the bus, the clock and the runner
+typedef struct TEA5767_SoakContext {
+    TEA5767_FaultRate rate;
+    unsigned long long us = 0;     // virtual time
+    unsigned long seed = 1;
+
+    // watchdog of the current operation
+    byte watch = 0;
+    unsigned long long opStart = 0;
+    unsigned long long latencyStart = 0;  // latency of the operation from here, after any simulated idle
+    unsigned long spin = 0;
+
+    // faults
+    unsigned long transfers = 0;
+    unsigned long faults = 0;
+    byte faultPending = 0;
+    unsigned long long faultTime = 0;
+    std::vector<unsigned long> recovery;  // ms from a fault to the next good read
+
+    // xorshift32, deterministic for a seed
+    unsigned long random() {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        seed &= 0xFFFFFFFFUL;
+        return seed;
+    }
+    unsigned long random(unsigned long n) { return random() % n; }
+    bool chance(float p) { return p > 0 && random(1000000) < p * 1000000; }
+
+    void elapse(unsigned long long t) {
+        us += t;
+        spin = 0;
+        if (watch && us - opStart > TEA5767_SOAK_HANG_MS * 1000) {
+            watch = 0;
+            throw TEA5767_SoakHang();
+        }
+    }
+} TEA5767_SoakContext;
+
+// Virtual time
+class TEA5767_SimClock {
+   private:
+    TEA5767_SoakContext *ctx;
+
+   public:
+    TEA5767_SimClock(TEA5767_SoakContext &ctx) : ctx(&ctx) {}
+
+    unsigned long millis() {
+        if (ctx->watch && ++ctx->spin > TEA5767_SOAK_SPIN) {
+            ctx->watch = 0;
+            throw TEA5767_SoakHang();
+        }
+        return ctx->us / 1000;
+    }
+    void delay(unsigned long ms) { ctx->elapse((unsigned long long)ms * 1000); }
+};
+
+// A TEA5767 with stations on the band
+class TEA5767_SimBus {
+   private:
+    TEA5767_SoakContext *ctx;
+    byte reg[5] = {0};
+
+   public:
+    unsigned int stations[10] = {8810, 8970, 9150, 9390, 9610, 9800, 10010, 10230, 10450, 10690};  // 10KHz
+    byte levels[10] = {12, 6, 14, 9, 5, 13, 7, 11, 15, 6};
+    byte noise = 3;
+    int ppm = 0;  // crystal error, the LO is off by LO * ppm
+
+    TEA5767_SimBus(TEA5767_SoakContext &ctx) : ctx(&ctx) {}
+
+    byte write(const byte *data, byte len) {
+        for (byte i = 0; i < len && i < 5; i++) {
+            reg[i] = data[i];
+        }
+        return 0;
+    }
+
+    byte read(byte *data, byte len) {
+        unsigned int PLL = ((reg[0] & 0x3F) << 8) + reg[1];
+        byte high = (reg[2] >> TEA5767_MASK_SIDE_INJECTION) & 1;
+        byte standby = (reg[3] >> TEA5767_MASK_STANDBY) & 1;
+        long LO = (long)PLL * TEA5767_XTAL / 4;
+        LO += LO / 1000 * ppm / 1000;
+        long freq = high ? LO - 225000 : LO + 225000;  // Hz
+
+        // strongest station around, -4 ADC level per 50KHz off
+        int level = 0;
+        long off = 0;
+        for (byte i = 0; i < 10; i++) {
+            long d = freq - stations[i] * 10000L;
+            int l = levels[i] - (int)(labs(d) / 50000) * 4;
+            if (labs(d) <= 150000 && l > level) {
+                level = l;
+                off = d;
+            }
+        }
+
+        byte ADCLevel, IFCounter;
+        if (level > noise) {
+            long IFOff = off / TEA5767_IF_STEP;
+            ADCLevel = level;
+            IFCounter = TEA5767_IF_CENTER + (high ? IFOff : -IFOff) + (int)ctx->random(3) - 1;
+        } else {
+            ADCLevel = noise + ctx->random(3);
+            IFCounter = 0x20 + ctx->random(40);
+        }
+        if (standby) {
+            ADCLevel = 0;
+        }
+
+        byte raw[5];
+        raw[0] = ((!standby) << TEA5767_MASK_READY_FLAG) | (reg[0] & 0x3F);
+        raw[1] = reg[1];
+        raw[2] = IFCounter & 0x7F;
+        raw[3] = min(ADCLevel, (byte)15) << 4;
+        raw[4] = 0;
+        for (byte i = 0; i < len && i < 5; i++) {
+            data[i] = raw[i];
+        }
+        return len;
+    }
+};
+
+// Fault injection on Bus
+template <class Bus = TEA5767_SimBus>
+class TEA5767_FaultBus {
+   private:
+    TEA5767_SoakContext *ctx;
+    Bus bus;
+
+    void fault() {
+        ctx->faults++;
+        if (!ctx->faultPending) {
+            ctx->faultPending = 1;
+            ctx->faultTime = ctx->us;
+        }
+    }
+
+    void transfer() {
+        ctx->transfers++;
+        ctx->elapse(TEA5767_SOAK_TRANSFER_US);
+        if (ctx->chance(ctx->rate.delay)) {
+            fault();
+            ctx->elapse((1 + ctx->random(ctx->rate.delayMax)) * 1000ULL);
+        }
+    }
+
+   public:
+    TEA5767_FaultBus(TEA5767_SoakContext &ctx, const Bus &bus) : ctx(&ctx), bus(bus) {}
+
+    byte write(const byte *data, byte len) {
+        byte buf[5];
+        for (byte i = 0; i < len && i < 5; i++) {
+            buf[i] = data[i];
+        }
+
+        transfer();
+        if (ctx->chance(ctx->rate.drop)) {
+            fault();
+            return 2;  // NACK on address
+        }
+        if (ctx->chance(ctx->rate.corrupt)) {
+            fault();
+            buf[ctx->random(len)] ^= 1 << ctx->random(8);
+        }
+        if (ctx->chance(ctx->rate.truncate)) {
+            fault();
+            bus.write(buf, 1 + ctx->random(len - 1));
+            return 3;  // NACK on data
+        }
+        return bus.write(buf, len);
+    }
+
+    byte read(byte *data, byte len) {
+        transfer();
+        if (ctx->chance(ctx->rate.drop)) {
+            fault();
+            return 0;
+        }
+        byte rec = bus.read(data, len);
+        if (ctx->chance(ctx->rate.truncate)) {
+            fault();
+            return 1 + ctx->random(len - 1);
+        }
+        if (ctx->chance(ctx->rate.corrupt)) {
+            fault();
+            data[ctx->random(len)] ^= 1 << ctx->random(8);
+            return rec;
+        }
+        if (ctx->chance(ctx->rate.zeroPLL)) {
+            fault();
+            data[0] &= 0xC0;
+            data[1] = 0;
+            return rec;
+        }
+
+        // good read
+        if (ctx->faultPending) {
+            ctx->recovery.push_back((ctx->us - ctx->faultTime) / 1000);
+            ctx->faultPending = 0;
+        }
+        return rec;
+    }
+};
+
+// Runner
+class TEA5767_Soak {
+   public:
+    typedef TEA5767_Driver<TEA5767_FaultBus<TEA5767_SimBus>, TEA5767_SimClock> Radio;
+
+    TEA5767_SoakContext ctx;
+    unsigned long hangs[TEA5767_SOAK_OPS] = {0};
+    unsigned long outOfRange = 0;  // preset index out of range after an operation
+    std::vector<unsigned long> latency[TEA5767_SOAK_OPS];  // ms
+
+   private:
+    Radio *radio = NULL;
+
+    void create() {
+        delete radio;
+        radio = new Radio(TEA5767_FaultBus<TEA5767_SimBus>(ctx, TEA5767_SimBus(ctx)), TEA5767_SimClock(ctx));
+    }
+
+    float randomFreq() {
+        return (radio->status.minChannel() + 10 * ctx.random((radio->status.maxChannel() - radio->status.minChannel()) / 10)) / 100.0;
+    }
+
+    void execute(byte op) {
+        byte ssl = (ctx.random(2) == 0) ? TEA5767_SSL_MID : TEA5767_SSL_HIGH;
+
+        switch (op) {
+            case TEA5767_SOAK_SET_STATION:
+                radio->setStation(randomFreq());
+                break;
+            case TEA5767_SOAK_SEARCH:
+                radio->searchingFreq = randomFreq();
+                radio->searchStation(ctx.random(2) ? TEA5767_UP : TEA5767_DOWN, ssl);
+                for (int i = 0; i < TEA5767_SOAK_SEARCH_STEPS && radio->searchProcessStatus == TEA5767_SEARCH_PENDING; i++) {
+                    radio->searchProcess();
+                }
+                radio->searchProcessStatus = TEA5767_SEARCH_STOP;
+                break;
+            case TEA5767_SOAK_SCAN:
+                radio->scanStation(ssl);
+                break;
+            case TEA5767_SOAK_RESCAN:
+                radio->rescanStation(ssl);
+                while (radio->rescanProcess(TEA5767_RESCAN_BATCH) == TEA5767_SEARCH_PENDING) {
+                    ctx.elapse(10000);  // loop() of TEA5767_Task, process(); delay(10);
+                }
+                break;
+            case TEA5767_SOAK_NEXT_PRESET:
+                radio->nextPreset();
+                break;
+            case TEA5767_SOAK_PREV_PRESET:
+                radio->prevPreset();
+                break;
+            case TEA5767_SOAK_DELETE_PRESET:
+                radio->deleteCurFreqPreset();
+                break;
+            case TEA5767_SOAK_TOGGLE:
+                switch (ctx.random(6)) {
+                    case 0:
+                        radio->toggleMute(ctx.random(3));
+                        break;
+                    case 1:
+                        radio->toggleSoftMute();
+                        break;
+                    case 2:
+                        radio->toggleHighCutControl();
+                        break;
+                    case 3:
+                        radio->toggleStereoNoiseCancelling();
+                        break;
+                    case 4:
+                        radio->toggleDeemphasisTimeConstant();
+                        break;
+                    default:
+                        radio->toggleMode();
+                        break;
+                }
+                break;
+            case TEA5767_SOAK_PAUSE_RESUME:
+                radio->pause();
+                ctx.elapse((1 + ctx.random(1000)) * 1000ULL);  // idle in standby, not latency
+                ctx.latencyStart = ctx.us;
+                radio->resume();
+                break;
+            default:
+                radio->read_status();
+                break;
+        }
+    }
+
+    // every preset index the driver may use is inside the array
+    bool presetInRange() {
+        int count = radio->presetCount();
+        int cur = radio->currentPreset();
+        if (count < 0 || (count == 0 && cur != 0) || (count > 0 && !between(cur, 0, count - 1))) {
+            return false;
+        }
+        for (int i = 0; i < count; i++) {
+            float f = radio->presetAt(i);
+            if (f < radio->status.minFreq() || f > radio->status.maxFreq() || (i > 0 && f < radio->presetAt(i - 1))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static unsigned long percentile(std::vector<unsigned long> v, int p) {
+        if (v.empty()) {
+            return 0;
+        }
+        std::sort(v.begin(), v.end());
+        return v[std::min(v.size() - 1, v.size() * p / 100)];
+    }
+
+   public:
+    TEA5767_Soak(unsigned long seed) {
+        ctx.seed = seed ? seed : 1;
+        create();
+    }
+
+    ~TEA5767_Soak() {
+        delete radio;
+    }
+
+    // scan and rescan are rare, they take ~20s each
+    void run(unsigned long ops) {
+        for (unsigned long n = 0; n < ops; n++) {
+            static const byte quick[] = {TEA5767_SOAK_SET_STATION, TEA5767_SOAK_SEARCH, TEA5767_SOAK_NEXT_PRESET,
+                                         TEA5767_SOAK_PREV_PRESET, TEA5767_SOAK_DELETE_PRESET, TEA5767_SOAK_TOGGLE,
+                                         TEA5767_SOAK_PAUSE_RESUME, TEA5767_SOAK_READ_STATUS};
+            unsigned long r = ctx.random(100);
+            byte op = (r < 2) ? TEA5767_SOAK_SCAN : (r < 4) ? TEA5767_SOAK_RESCAN : quick[ctx.random(sizeof(quick))];
+
+            ctx.opStart = ctx.us;
+            ctx.latencyStart = ctx.us;
+            ctx.spin = 0;
+            ctx.watch = 1;
+            try {
+                execute(op);
+                ctx.watch = 0;
+                latency[op].push_back((ctx.us - ctx.latencyStart) / 1000);
+            } catch (TEA5767_SoakHang &) {
+                ctx.watch = 0;
+                hangs[op]++;
+                printf("HANG : op %d at %llu ms\n", op, ctx.us / 1000);
+                create();
+            }
+
+            if (!presetInRange()) {
+                outOfRange++;
+                printf("PRESET OUT OF RANGE : op %d, count %d, current %d\n", op, radio->presetCount(), radio->currentPreset());
+            }
+        }
+    }
+
+    void report() {
+        static const char *name[TEA5767_SOAK_OPS] = {"setStation", "search", "scan", "rescan", "nextPreset",
+                                                     "prevPreset", "deletePreset", "toggle", "resume", "read_status"};
+
+        printf("%-14s %8s %8s %8s %8s %8s %6s\n", "op (ms)", "count", "p50", "p90", "p99", "max", "hang");
+        for (byte i = 0; i < TEA5767_SOAK_OPS; i++) {
+            printf("%-14s %8lu %8lu %8lu %8lu %8lu %6lu\n", name[i], (unsigned long)latency[i].size(), percentile(latency[i], 50),
+                   percentile(latency[i], 90), percentile(latency[i], 99), percentile(latency[i], 100), hangs[i]);
+        }
+        printf("transfers %lu, faults %lu, recovery ms p50 %lu p99 %lu max %lu\n", ctx.transfers, ctx.faults,
+               percentile(ctx.recovery, 50), percentile(ctx.recovery, 99), percentile(ctx.recovery, 100));
+        printf("preset out of range %lu\n", outOfRange);
+    }
+};
+
+#endif  // TEA5767_SOAK_H_
@@ -0,0 +1,41 @@
+/*
+	Project  : LaLiMat project (https://www.youtube.com/playlist?list=PLJBKmE2nNweRXOebZjydkMEiq2pHtBMOS in Chinese)
+ 	file     : soak.cpp
+	Author   : ykchau
+ 	youtube  : youtube.com/ykchau888
+  	Licenese : GPL-3.0
+   	Please let me know if you use it commercial project.
+*/
+
+/*
+    Fault-injection soak of TEA5767_Driver, see TEA5767_Soak.h
+    usage : soak [ops] [seed] [fault rate]
+    built with AddressSanitizer by the Makefile, an out of bounds preset access aborts with its report
+    exit 1 on a hang or a preset index out of range
+*/
+#include "TEA5767_Soak.h"
+
+int main(int argc, char **argv) {
+    unsigned long ops = (argc > 1) ? strtoul(argv[1], NULL, 10) : 2000;
+    unsigned long seed = (argc > 2) ? strtoul(argv[2], NULL, 10) : 1;
+    float rate = (argc > 3) ? atof(argv[3]) : 0.02;
+
+    Serial.enabled = false;  // driver log
+
+    TEA5767_Soak soak(seed);
+    soak.ctx.rate.drop = rate;
+    soak.ctx.rate.delay = rate;
+    soak.ctx.rate.truncate = rate / 2;
+    soak.ctx.rate.corrupt = rate / 2;
+    soak.ctx.rate.zeroPLL = rate / 2;
+
+    printf("soak : %lu ops, seed %lu, fault rate %.3f\n", ops, seed, rate);
+    soak.run(ops);
+    soak.report();
+
+    unsigned long hangs = 0;
+    for (byte i = 0; i < TEA5767_SOAK_OPS; i++) {
+        hangs += soak.hangs[i];
+    }
+    return (hangs > 0 || soak.outOfRange > 0) ? 1 : 0;
+}
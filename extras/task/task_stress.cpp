@@ -0,0 +1,246 @@
+/*
+	Project  : LaLiMat project (https://www.youtube.com/playlist?list=PLJBKmE2nNweRXOebZjydkMEiq2pHtBMOS in Chinese)
+ 	file     : task_stress.cpp
+	Author   : ykchau
+ 	youtube  : youtube.com/ykchau888
+  	Licenese : GPL-3.0
+   	Please let me know if you use it commercial project.
+*/
+
+/*
+    Producer / reader stress of TEA5767_Task.h with std::thread
+    built with ThreadSanitizer by the Makefile, a data race aborts with its report
+    usage : task_stress [iterations]
+    exit 1 on a lost, duplicated, reordered or torn value
+*/
+#include <stdio.h>
+
+#include <thread>
+#include <vector>
+
+#include "TEA5767_Task.h"
+
+#define PRODUCERS 3
+#define READERS   2
+
+static std::atomic<unsigned long> failures{0};
+
+static void check(bool ok, const char *what, unsigned long value) {
+    if (!ok) {
+        if (failures++ < 10) {
+            printf("FAIL : %s (%lu)\n", what, value);
+        }
+    }
+}
+
+// commands carry (producer, sequence) in arg1 and freq
+static TEA5767_Command command(byte producer, unsigned long n) {
+    TEA5767_Command cmd = {TEA5767_CMD_SET_STATION, (float)n, producer, 0};
+    return cmd;
+}
+
+static void testSPSC(unsigned long count) {
+    TEA5767_SPSCQueue<16> queue;
+
+    std::thread producer([&] {
+        for (unsigned long n = 0; n < count; n++) {
+            while (!queue.push(command(0, n))) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    unsigned long expected = 0;
+    TEA5767_Command cmd;
+    while (expected < count) {
+        if (queue.pop(&cmd)) {
+            check((unsigned long)cmd.freq == expected, "SPSC order", expected);
+            expected++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    check(!queue.pop(&cmd), "SPSC empty at the end", 0);
+    printf("SPSC  : %lu commands\n", count);
+}
+
+static void testMPSC(unsigned long count) {
+    TEA5767_MPSCQueue<16> queue;
+    std::vector<std::thread> producers;
+
+    for (byte p = 0; p < PRODUCERS; p++) {
+        producers.push_back(std::thread([&queue, p, count] {
+            for (unsigned long n = 0; n < count; n++) {
+                while (!queue.push(command(p, n))) {
+                    std::this_thread::yield();
+                }
+            }
+        }));
+    }
+
+    // in order per producer, nothing lost
+    unsigned long expected[PRODUCERS] = {0};
+    unsigned long total = 0;
+    TEA5767_Command cmd;
+    while (total < count * PRODUCERS) {
+        if (queue.pop(&cmd)) {
+            check(cmd.arg1 < PRODUCERS, "MPSC producer", cmd.arg1);
+            if (cmd.arg1 < PRODUCERS) {
+                check((unsigned long)cmd.freq == expected[cmd.arg1], "MPSC order", expected[cmd.arg1]);
+                expected[cmd.arg1] = (unsigned long)cmd.freq + 1;
+            }
+            total++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    for (auto &t : producers) {
+        t.join();
+    }
+    check(!queue.pop(&cmd), "MPSC empty at the end", 0);
+    printf("MPSC  : %d x %lu commands\n", PRODUCERS, count);
+}
+
+// every field of snapshot k is derived from k, a mix of two writes is a torn read
+static void fill(TEA5767_Snapshot *snap, unsigned long k) {
+    *snap = TEA5767_Snapshot();
+    for (byte i = 0; i < 5; i++) {
+        snap->status.rawData[i] = (k + i) & 0xFF;
+    }
+    snap->xtalPPM = -(int)(k & 0x7FFF);
+    snap->searchingFreq = k & 0xFFFF;
+    snap->presetCount = k;
+    snap->curPreset = -(int)k;
+    snap->curPresetFreq = k & 0xFFFF;
+    snap->seq = k;
+}
+
+static bool consistent(const TEA5767_Snapshot &snap) {
+    TEA5767_Snapshot ref;
+    fill(&ref, snap.seq);
+    return memcmp(ref.status.rawData, snap.status.rawData, 5) == 0 && ref.xtalPPM == snap.xtalPPM &&
+           ref.searchingFreq == snap.searchingFreq && ref.presetCount == snap.presetCount &&
+           ref.curPreset == snap.curPreset && ref.curPresetFreq == snap.curPresetFreq;
+}
+
+static void testSeqlock(unsigned long count) {
+    TEA5767_SnapshotLock lock;
+    std::atomic<bool> done{false};
+    std::vector<std::thread> readers;
+    std::atomic<unsigned long> reads{0};
+
+    TEA5767_Snapshot first;
+    fill(&first, 0);
+    lock.write(first);
+
+    for (byte r = 0; r < READERS; r++) {
+        readers.push_back(std::thread([&] {
+            unsigned long last = 0;
+            TEA5767_Snapshot snap;
+            while (!done.load(std::memory_order_acquire)) {
+                if (lock.tryRead(&snap)) {
+                    check(consistent(snap), "seqlock torn read", snap.seq);
+                    check(snap.seq >= last, "seqlock went back", snap.seq);
+                    last = snap.seq;
+                    reads++;
+                }
+                std::this_thread::yield();
+            }
+        }));
+    }
+
+    TEA5767_Snapshot snap;
+    for (unsigned long k = 1; k <= count; k++) {
+        fill(&snap, k);
+        lock.write(snap);
+        if ((k & 15) == 0) {
+            std::this_thread::yield();
+        }
+    }
+    done.store(true, std::memory_order_release);
+    for (auto &t : readers) {
+        t.join();
+    }
+
+    lock.read(&snap);
+    check(snap.seq == count && consistent(snap), "seqlock last write", snap.seq);
+    printf("Seqlock : %lu writes, %lu reads\n", count, reads.load());
+}
+
+// A TEA5767 on the host Wire, ready and locked on the channel written
+static byte reg[5];
+static byte tunerWrite(byte, const byte *data, byte len) {
+    memcpy(reg, data, min(len, (byte)5));
+    return 0;
+}
+static byte tunerRead(byte, byte *data, byte len) {
+    byte raw[5] = {(byte)(0x80 | (reg[0] & 0x3F)), reg[1], TEA5767_IF_CENTER, 0xA0, 0};
+    memcpy(data, raw, min(len, (byte)5));
+    return len;
+}
+
+// UI tasks post, the radio task processes, the others read snapshots
+static void testTask(unsigned long count) {
+    Wire.onWrite = tunerWrite;
+    Wire.onRead = tunerRead;
+
+    TEA5767 radio;
+    TEA5767_Task<TEA5767_MPSCQueue<8>> task(radio);
+    std::atomic<unsigned long> posted{0};
+    std::atomic<bool> done{false};
+    std::vector<std::thread> threads;
+
+    for (byte p = 0; p < PRODUCERS; p++) {
+        threads.push_back(std::thread([&task, &posted, p, count] {
+            for (unsigned long n = 0; n < count; n++) {
+                TEA5767_Command cmd = {TEA5767_CMD_SET_STATION, (float)(88 + (n + p) % 20), 0, 0};
+                while (!task.post(cmd)) {
+                    std::this_thread::yield();
+                }
+                posted++;
+            }
+        }));
+    }
+    for (byte r = 0; r < READERS; r++) {
+        threads.push_back(std::thread([&task, &done] {
+            unsigned long last = 0;
+            TEA5767_Snapshot snap;
+            while (!done.load(std::memory_order_acquire)) {
+                if (task.trySnapshot(&snap)) {
+                    check(snap.seq >= last, "task snapshot went back", snap.seq);
+                    check(between(snap.status.currentFreq(snap.xtalPPM), 87.5, 108.0), "task snapshot freq", snap.seq);
+                    last = snap.seq;
+                }
+                std::this_thread::yield();
+            }
+        }));
+    }
+
+    // radio task
+    unsigned long executed = 0;
+    while (executed < count * PRODUCERS) {
+        executed += task.process();
+        std::this_thread::yield();
+    }
+    done.store(true, std::memory_order_release);
+    for (auto &t : threads) {
+        t.join();
+    }
+    check(posted.load() == count * PRODUCERS, "task commands posted", posted.load());
+    printf("Task  : %lu commands from %d tasks\n", executed, PRODUCERS);
+}
+
+int main(int argc, char **argv) {
+    unsigned long count = (argc > 1) ? strtoul(argv[1], NULL, 10) : 20000;
+
+    Serial.enabled = false;  // driver log
+
+    testSPSC(count);
+    testMPSC(count);
+    testSeqlock(count);
+    testTask(count / 20);
+
+    printf("%s, %lu failures\n", failures ? "FAILED" : "OK", failures.load());
+    return failures ? 1 : 0;
+}
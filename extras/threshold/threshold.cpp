@@ -0,0 +1,101 @@
+/*
+	Project  : LaLiMat project (https://www.youtube.com/playlist?list=PLJBKmE2nNweRXOebZjydkMEiq2pHtBMOS in Chinese)
+ 	file     : threshold.cpp
+	Author   : ykchau
+ 	youtube  : youtube.com/ykchau888
+  	Licenese : GPL-3.0
+   	Please let me know if you use it commercial project.
+*/
+
+/*
+    Adaptive against fixed station thresholds of scanStation() on TEA5767_SimBus
+    at a quiet (3) and a noisy (8) noise floor, with the peak verify on
+    reports the presets, how many are real stations, and the verification retunes
+    usage : threshold [seed]
+    exit 1 if the adaptive threshold finds fewer real stations, or keeps more false ones, than the fixed one
+*/
+#include "TEA5767_Soak.h"
+
+// TEA5767_SimBus counting the writes
+class CountBus {
+   private:
+    TEA5767_SimBus bus;
+    unsigned long *writes;
+
+   public:
+    CountBus(const TEA5767_SimBus &bus, unsigned long &writes) : bus(bus), writes(&writes) {}
+    byte write(const byte *data, byte len) {
+        (*writes)++;
+        return bus.write(data, len);
+    }
+    byte read(byte *data, byte len) { return bus.read(data, len); }
+};
+
+typedef struct Result {
+    int presets;
+    int real;               // presets within 100KHz of a station of TEA5767_SimBus
+    unsigned long retunes;  // verify writes of the scan peaks
+} Result;
+
+// writes of scanStation()
+static unsigned long scan(unsigned long seed, byte noise, byte adaptive, byte verify, Result *r) {
+    TEA5767_SoakContext ctx;
+    ctx.seed = seed;
+    TEA5767_SimBus sim(ctx);
+    sim.noise = noise;
+    unsigned long writes = 0;
+
+    TEA5767_Driver<CountBus, TEA5767_SimClock> radio(CountBus(sim, writes), TEA5767_SimClock(ctx));
+    radio.adaptiveThreshold = adaptive;
+    radio.scanVerifyPeak = verify;
+
+    writes = 0;
+    radio.scanStation(TEA5767_SSL_HIGH);
+
+    r->presets = radio.presetCount();
+    r->real = 0;
+    for (int i = 0; i < radio.presetCount(); i++) {
+        for (byte s = 0; s < 10; s++) {
+            if (fabs(radio.presetAt(i) - sim.stations[s] / 100.0) < 0.15) {
+                r->real++;
+                break;
+            }
+        }
+    }
+    return writes;
+}
+
+// the sweep is the same with or without the verify, which only adds the retunes after it
+static Result compare(unsigned long seed, byte noise, byte adaptive) {
+    Result r, plain;
+    unsigned long verified = scan(seed, noise, adaptive, TEA5767_SCAN_VERIFY_YES, &r);
+    unsigned long unverified = scan(seed, noise, adaptive, TEA5767_SCAN_VERIFY_NO, &plain);
+    r.retunes = verified - unverified;
+    return r;
+}
+
+int main(int argc, char **argv) {
+    unsigned long seed = (argc > 1) ? strtoul(argv[1], NULL, 10) : 1;
+    static const byte noises[] = {3, 8};
+    int failures = 0;
+
+    Serial.enabled = false;  // driver log
+
+    printf("%-6s %-9s %8s %6s %6s %8s\n", "noise", "threshold", "presets", "real", "false", "retunes");
+    for (byte n = 0; n < sizeof(noises); n++) {
+        Result fixed = compare(seed, noises[n], TEA5767_OFF);
+        Result adaptive = compare(seed, noises[n], TEA5767_ON);
+
+        printf("%-6d %-9s %8d %6d %6d %8lu\n", noises[n], "fixed", fixed.presets, fixed.real, fixed.presets - fixed.real,
+               fixed.retunes);
+        printf("%-6d %-9s %8d %6d %6d %8lu\n", noises[n], "adaptive", adaptive.presets, adaptive.real,
+               adaptive.presets - adaptive.real, adaptive.retunes);
+
+        if (adaptive.real < fixed.real || adaptive.presets - adaptive.real > fixed.presets - fixed.real) {
+            failures++;
+        }
+    }
+
+    printf("%s\n", failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,98 @@
+/*
+	Project  : LaLiMat project (https://www.youtube.com/playlist?list=PLJBKmE2nNweRXOebZjydkMEiq2pHtBMOS in Chinese)
+ 	file     : trace_replay.cpp
+	Author   : ykchau
+ 	youtube  : youtube.com/ykchau888
+  	Licenese : GPL-3.0
+   	Please let me know if you use it commercial project.
+*/
+
+/*
+    Record -> replay round trip of TEA5767_Trace.h
+    a field unit on TEA5767_FaultBus with the default 64 entry ring, streaming the trace out,
+    then a driver on TEA5767_ReplayBus running the same calls from the streamed trace
+    usage : trace_replay [seed] [fault rate]
+    exit 1 if the replay mismatches, overruns or leaves entries, or ends with other presets / frequency
+*/
+#include "TEA5767_Soak.h"
+#include "TEA5767_Trace.h"
+
+// Print into memory, the SD card / serial capture of the field unit
+class MemoryPrint : public Print {
+   public:
+    std::vector<byte> bytes;
+
+    size_t write(const byte *data, size_t len) override {
+        bytes.insert(bytes.end(), data, data + len);
+        return len;
+    }
+};
+
+typedef struct Outcome {
+    std::vector<float> presets;
+    unsigned int channel;
+} Outcome;
+
+// the same calls on the field unit and on the replay
+template <class Radio>
+static Outcome session(Radio &radio) {
+    radio.setStation(98.0);
+    radio.scanStation(TEA5767_SSL_HIGH);
+    radio.nextPreset();
+    radio.nextPreset();
+    radio.searchStation(TEA5767_UP, TEA5767_SSL_MID);
+    radio.rescanStation(TEA5767_SSL_HIGH);
+    radio.toggleMute(TEA5767_LEFT);
+
+    Outcome o;
+    for (int i = 0; i < radio.presetCount(); i++) {
+        o.presets.push_back(radio.presetAt(i));
+    }
+    o.channel = radio.currentChannel();
+    return o;
+}
+
+int main(int argc, char **argv) {
+    unsigned long seed = (argc > 1) ? strtoul(argv[1], NULL, 10) : 1;
+    float rate = (argc > 2) ? atof(argv[2]) : 0.02;
+
+    Serial.enabled = false;  // driver log
+
+    // field unit
+    TEA5767_SoakContext ctx;
+    ctx.seed = seed;
+    ctx.rate.drop = rate;
+    ctx.rate.truncate = rate / 2;
+    ctx.rate.corrupt = rate / 2;
+
+    typedef TEA5767_FaultBus<TEA5767_SimBus> FieldBus;
+    TEA5767_RecorderBuffer<> recorder;
+    MemoryPrint capture;
+    TEA5767_Driver<TEA5767_RecordBus<FieldBus, TEA5767_SimClock>, TEA5767_SimClock> field(
+        TEA5767_RecordBus<FieldBus, TEA5767_SimClock>(recorder, FieldBus(ctx, TEA5767_SimBus(ctx)), TEA5767_SimClock(ctx)),
+        TEA5767_SimClock(ctx));
+    recorder.stream(&capture);
+    field.init();
+    Outcome recorded = session(field);
+    unsigned int entries = capture.bytes.size() / TEA5767_TRACE_BYTES;
+
+    // bench
+    TEA5767_Replay replay;
+    if (!replay.load(capture.bytes.data(), capture.bytes.size())) {
+        printf("load failed\n");
+        return 1;
+    }
+    TEA5767_Driver<TEA5767_ReplayBus, TEA5767_ReplayClock> bench((TEA5767_ReplayBus(replay)), TEA5767_ReplayClock(replay));
+    Outcome replayed = session(bench);
+
+    printf("trace : %u entries streamed, ring %u entries dropped %lu, faults %lu\n", entries, recorder.size(),
+           recorder.dropped, ctx.faults);
+    printf("replay : pos %u, mismatch %u, overrun %u\n", replay.pos, replay.mismatch, replay.overrun);
+    printf("presets : %u recorded, %u replayed, channel %u / %u\n", (unsigned int)recorded.presets.size(),
+           (unsigned int)replayed.presets.size(), recorded.channel, replayed.channel);
+
+    bool ok = recorder.dropped > 0 && replay.mismatch == 0 && replay.overrun == 0 && replay.finished() &&
+              recorded.presets == replayed.presets && recorded.channel == replayed.channel;
+    printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}